@@ -38,6 +38,9 @@ namespace Jazz2::Actors
 		_currentAnimationState(AnimState::Uninitialized),
 		_currentTransitionState(AnimState::Idle),
 		_currentTransitionCancellable(false),
+		_updateTier(ActorUpdateTier::Full),
+		_updateScheduled(true),
+		_skippedTimeMult(0.0f),
 		CollisionProxyID(Collisions::NullNode)
 	{
 	}
@@ -438,6 +441,15 @@ namespace Jazz2::Actors
 		}
 	}
 
+	void ActorBase::RequestSfx(const StringView& identifier, float gain, float pitch)
+	{
+		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
+		if (it != _metadata->Sounds.end()) {
+			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
+			_levelHandler->RequestSfx(it->second.Buffers[idx].get(), Vector3f(_pos.X, _pos.Y, 0.0f), gain, pitch);
+		}
+	}
+
 	void ActorBase::SetAnimation(const StringView& identifier)
 	{
 		if (_metadata == nullptr) {
@@ -1235,6 +1247,16 @@ namespace Jazz2::Actors
 
 	void ActorBase::ActorRenderer::OnUpdate(float timeMult)
 	{
+		// Actors far from the view are updated only in scheduled frames with accumulated time
+		_owner->_skippedTimeMult += timeMult;
+		if (!_owner->_updateScheduled) {
+			BaseSprite::OnUpdate(timeMult);
+			return;
+		}
+
+		timeMult = _owner->_skippedTimeMult;
+		_owner->_skippedTimeMult = 0.0f;
+
 		_owner->OnUpdate(timeMult);
 
 		if (IsAnimationRunning()) {
@@ -1255,7 +1277,10 @@ namespace Jazz2::Actors
 				}
 			}
 
-			UpdateVisibleFrames();
+			// Animation timer still runs to keep callbacks working, but frames are not needed outside of the view
+			if (_owner->_updateTier == ActorUpdateTier::Full) {
+				UpdateVisibleFrames();
+			}
 		}
 
 		BaseSprite::OnUpdate(timeMult);
@@ -52,6 +52,8 @@ namespace Jazz2::Actors
 		CanJump = 0x0400,
 		CanBeFrozen = 0x0800,
 		IsFacingLeft = 0x1000,
+		/// @brief Update actor every frame even if it's far from the view
+		AlwaysFullUpdate = 0x2000,
 
 		// Collision flags
 	
@@ -100,6 +102,17 @@ namespace Jazz2::Actors
 
 	DEFINE_ENUM_OPERATORS(MoveType);
 
+	enum class ActorUpdateTier : uint8_t {
+		/// @brief Actor is near the view, it's updated every frame
+		Full,
+		/// @brief Actor is outside of the view, it's updated every 2nd frame without animation
+		Reduced,
+		/// @brief Actor is far from the view, it's updated every 4th frame without animation
+		Dormant,
+
+		Count
+	};
+
 	enum class ActorRendererType {
 		Default,
 		Outline,
@@ -270,6 +283,7 @@ namespace Jazz2::Actors
 		void CreateSpriteDebris(const StringView& identifier, int count);
 
 		std::shared_ptr<AudioBufferPlayer> PlaySfx(const StringView& identifier, float gain = 1.0f, float pitch = 1.0f);
+		void RequestSfx(const StringView& identifier, float gain = 1.0f, float pitch = 1.0f);
 		void SetAnimation(const StringView& identifier);
 		bool SetAnimation(AnimState state);
 		bool SetTransition(AnimState state, bool cancellable, const std::function<void()>& callback = []() { });
@@ -341,6 +355,11 @@ namespace Jazz2::Actors
 		ActorState _state;
 		std::function<void()> _currentTransitionCallback;
 
+		// Update scheduling, managed by LevelHandler
+		ActorUpdateTier _updateTier;
+		bool _updateScheduled;
+		float _skippedTimeMult;
+
 		bool IsCollidingWithAngled(ActorBase* other);
 		bool IsCollidingWithAngled(const AABBf& aabb);
 
@@ -0,0 +1,80 @@
+﻿#include "ActorPool.h"
+
+#include "../../nCine/tracy.h"
+
+namespace Jazz2::Actors
+{
+	static const char TracyPoolName[] = "Actor Pool";
+
+	ActorPool::SizeClass ActorPool::_sizeClasses[MaxPooledSize / SizeGranularity] = { };
+	ActorPoolStatistics ActorPool::_stats = { };
+
+	void* ActorPool::Allocate(std::size_t size)
+	{
+		_stats.Allocations++;
+		_stats.FrameAllocations++;
+
+		if (size == 0 || size > MaxPooledSize) {
+			_stats.Fallbacks++;
+			return ::operator new(size);
+		}
+
+		std::size_t index = (size - 1) / SizeGranularity;
+		SizeClass& sizeClass = _sizeClasses[index];
+		if (sizeClass.FreeList == nullptr) {
+			AllocateChunk(sizeClass, (index + 1) * SizeGranularity);
+		}
+
+		FreeSlot* slot = sizeClass.FreeList;
+		sizeClass.FreeList = slot->Next;
+		_stats.LiveSlots++;
+
+		TracyAllocN(slot, size, TracyPoolName);
+		return slot;
+	}
+
+	void ActorPool::Deallocate(void* ptr, std::size_t size) noexcept
+	{
+		if (ptr == nullptr) {
+			return;
+		}
+
+		if (size == 0 || size > MaxPooledSize) {
+			::operator delete(ptr);
+			return;
+		}
+
+		TracyFreeN(ptr, TracyPoolName);
+
+		SizeClass& sizeClass = _sizeClasses[(size - 1) / SizeGranularity];
+		FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+		slot->Next = sizeClass.FreeList;
+		sizeClass.FreeList = slot;
+		_stats.LiveSlots--;
+	}
+
+	void ActorPool::ResetFrameStatistics()
+	{
+		TracyPlot("Pooled Actors", static_cast<int64_t>(_stats.LiveSlots));
+		TracyPlot("Pooled Actor Allocations", static_cast<int64_t>(_stats.FrameAllocations));
+
+		_stats.FrameAllocations = 0;
+	}
+
+	void ActorPool::AllocateChunk(SizeClass& sizeClass, std::size_t slotSize)
+	{
+		std::size_t slotCount = std::max(ChunkSize / slotSize, (std::size_t)4);
+		std::unique_ptr<uint8_t[]>& chunk = sizeClass.Chunks.emplace_back(std::make_unique<uint8_t[]>(slotCount * slotSize));
+
+		// Push slots in reverse order, so they are handed out in ascending address order
+		uint8_t* data = chunk.get();
+		for (std::size_t i = slotCount; i > 0; i--) {
+			FreeSlot* slot = reinterpret_cast<FreeSlot*>(data + (i - 1) * slotSize);
+			slot->Next = sizeClass.FreeList;
+			sizeClass.FreeList = slot;
+		}
+
+		_stats.ReservedSlots += (uint32_t)slotCount;
+		_stats.ReservedBytes += slotCount * slotSize;
+	}
+}
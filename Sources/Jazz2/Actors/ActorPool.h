@@ -0,0 +1,105 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Actors
+{
+	/// Statistics of pooled actor allocations
+	struct ActorPoolStatistics {
+		/// Number of slots currently in use
+		uint32_t LiveSlots;
+		/// Number of slots reserved by all size classes (both used and free)
+		uint32_t ReservedSlots;
+		/// Number of bytes reserved by all size classes
+		uint64_t ReservedBytes;
+		/// Total number of allocations served by the pool
+		uint64_t Allocations;
+		/// Number of allocations that were too large and fell back to the heap
+		uint64_t Fallbacks;
+		/// Number of allocations in the current frame
+		uint32_t FrameAllocations;
+	};
+
+	/// Fixed-size slot allocator for short-lived actors (shots, explosions, spawned events)
+	/*! Slots are grouped into size classes and recycled through an intrusive free list,
+		so an actor and its `std::shared_ptr` control block share one slot that is reused
+		once the last reference is dropped. The pool is not thread-safe, actors must be
+		created and released on the main thread. */
+	class ActorPool
+	{
+	public:
+		static constexpr std::size_t SizeGranularity = 64;
+		static constexpr std::size_t MaxPooledSize = 4096;
+		static constexpr std::size_t ChunkSize = 32768;
+
+		static void* Allocate(std::size_t size);
+		static void Deallocate(void* ptr, std::size_t size) noexcept;
+
+		static const ActorPoolStatistics& GetStatistics() {
+			return _stats;
+		}
+
+		/// Resets per-frame counters, should be called once at the beginning of each frame
+		static void ResetFrameStatistics();
+
+	private:
+		struct FreeSlot {
+			FreeSlot* Next;
+		};
+
+		struct SizeClass {
+			FreeSlot* FreeList;
+			SmallVector<std::unique_ptr<uint8_t[]>, 0> Chunks;
+		};
+
+		static SizeClass _sizeClasses[MaxPooledSize / SizeGranularity];
+		static ActorPoolStatistics _stats;
+
+		static void AllocateChunk(SizeClass& sizeClass, std::size_t slotSize);
+	};
+
+	/// Standard allocator adapter over @ref ActorPool, intended to be used with `std::allocate_shared()`
+	template<typename T>
+	class ActorPoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		ActorPoolAllocator() noexcept = default;
+
+		template<typename U>
+		ActorPoolAllocator(const ActorPoolAllocator<U>&) noexcept { }
+
+		T* allocate(std::size_t n) {
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported by ActorPool");
+			return static_cast<T*>(ActorPool::Allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, std::size_t n) noexcept {
+			ActorPool::Deallocate(ptr, n * sizeof(T));
+		}
+
+		template<typename U>
+		bool operator==(const ActorPoolAllocator<U>&) const noexcept {
+			return true;
+		}
+
+		template<typename U>
+		bool operator!=(const ActorPoolAllocator<U>&) const noexcept {
+			return false;
+		}
+	};
+
+	/// Creates a new actor instance in a recycled pool slot
+	template<typename T, typename ...Args>
+	std::shared_ptr<T> CreatePooledActor(Args&&... args)
+	{
+		return std::allocate_shared<T>(ActorPoolAllocator<T>(), std::forward<Args>(args)...);
+	}
+}
@@ -58,7 +58,7 @@ namespace Jazz2::Actors::Collectibles
 	{
 		CreateParticleDebris();
 
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		for (int i = 0; i < 10; i++) {
 			float fx = Random().NextFloat(-16.0f, 16.0f);
@@ -110,10 +110,9 @@ namespace Jazz2::Actors::Collectibles
 					float texScaleY = (float(chainAnim.Base->FrameDimensions.Y) / float(texSize.Y));
 					float texBiasY = (float(chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(chainAnim.Base->FrameDimensions.X * _pieces[i].Scale, chainAnim.Base->FrameDimensions.Y * _pieces[i].Scale);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 0.7f).Data());
+					command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->material().spriteSizeUniform()->setFloatValue(chainAnim.Base->FrameDimensions.X * _pieces[i].Scale, chainAnim.Base->FrameDimensions.Y * _pieces[i].Scale);
+					command->material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 0.7f).Data());
 
 					auto& pos = _pieces[i].Pos;
 					command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f).RotateZ(_pieces[i].Angle));
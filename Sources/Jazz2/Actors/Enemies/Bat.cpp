@@ -67,7 +67,7 @@ namespace Jazz2::Actors::Enemies
 					_noiseCooldown -= timeMult;
 				} else {
 					_noiseCooldown = 60.0f;
-					PlaySfx("Noise"_s);
+					RequestSfx("Noise"_s);
 				}
 			} else {
 				if (_currentTransitionState != AnimState::Idle) {
@@ -2,6 +2,7 @@
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
+#include "../../ActorPool.h"
 
 #include "../../../../nCine/Base/Random.h"
 
@@ -77,9 +78,9 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					_state = StateTransition;
 					SetTransition((AnimState)1073741826, false, [this]() {
-						PlaySfx("ThrowFireball"_s);
+						RequestSfx("ThrowFireball"_s);
 
-						std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+						std::shared_ptr<Fireball> fireball = CreatePooledActor<Fireball>();
 						uint8_t fireballParams[2] = { _theme, (uint8_t)(IsFacingLeft() ? 1 : 0) };
 						fireball->OnActivated({
 							.LevelHandler = _levelHandler,
@@ -100,7 +101,7 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					SetState(ActorState::CanBeFrozen, false);
 
-					PlaySfx("Disappear"_s, 0.8f);
+					RequestSfx("Disappear"_s, 0.8f);
 
 					_state = StateTransition;
 					SetTransition((AnimState)1073741825, false, [this]() {
@@ -175,7 +176,7 @@ namespace Jazz2::Actors::Bosses
 			_stateTime = 30.0f;
 		});
 
-		PlaySfx("Appear"_s, 0.8f);
+		RequestSfx("Appear"_s, 0.8f);
 	}
 
 	Task<bool> Bilsy::Fireball::OnActivatedAsync(const ActorActivationDetails& details)
@@ -205,7 +206,7 @@ namespace Jazz2::Actors::Bosses
 
 		SetAnimation((AnimState)1073741828);
 
-		PlaySfx("FireStart"_s);
+		RequestSfx("FireStart"_s);
 
 		async_return true;
 	}
@@ -4,6 +4,7 @@
 #include "../../Player.h"
 #include "../../Explosion.h"
 #include "../../Weapons/ShotBase.h"
+#include "../../ActorPool.h"
 
 #include "../../../../nCine/Base/Random.h"
 
@@ -134,7 +135,7 @@ namespace Jazz2::Actors::Bosses
 					_stateTime = 20.0f;
 					_rocketsLeft = 5;
 
-					PlaySfx("PreAttack"_s);
+					RequestSfx("PreAttack"_s);
 				}
 				break;
 			}
@@ -147,12 +148,12 @@ namespace Jazz2::Actors::Bosses
 						FireRocket();
 						_rocketsLeft--;
 
-						PlaySfx("Attack"_s);
+						RequestSfx("Attack"_s);
 					} else {
 						_state = StateNewDirection;
 						_stateTime = 100.0f;
 
-						PlaySfx("PostAttack"_s);
+						RequestSfx("PostAttack"_s);
 					}
 				}
 				break;
@@ -183,7 +184,7 @@ namespace Jazz2::Actors::Bosses
 			_noiseCooldown -= timeMult;
 		} else {
 			_noiseCooldown = 120.0f;
-			PlaySfx("Noise"_s, 0.2f);
+			RequestSfx("Noise"_s, 0.2f);
 		}
 
 		_stateTime -= timeMult;
@@ -272,7 +273,7 @@ namespace Jazz2::Actors::Bosses
 		if (found) {
 			Vector2f diff = (targetPos - _pos).Normalized();
 
-			std::shared_ptr<Rocket> rocket = std::make_shared<Rocket>();
+			std::shared_ptr<Rocket> rocket = CreatePooledActor<Rocket>();
 			rocket->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = Vector3i((int)_pos.X + (IsFacingLeft() ? 10 : -10), (int)_pos.Y + 10, _renderer.layer() + 4)
@@ -4,6 +4,12 @@
 
 namespace Jazz2::Actors::Bosses
 {
+	BossBase::BossBase()
+	{
+		// Bosses are usually controlled by timers, so they shouldn't be slowed down
+		SetState(ActorState::AlwaysFullUpdate, true);
+	}
+
 	bool BossBase::OnPlayerDied()
 	{
 		if ((GetState() & (ActorState::IsCreatedFromEventMap | ActorState::IsFromGenerator)) != ActorState::None) {
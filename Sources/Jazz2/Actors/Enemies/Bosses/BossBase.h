@@ -7,6 +7,8 @@ namespace Jazz2::Actors::Bosses
 	class BossBase : public Enemies::EnemyBase
 	{
 	public:
+		BossBase();
+
 		virtual bool OnActivatedBoss() = 0;
 		virtual void OnDeactivatedBoss() { };
 
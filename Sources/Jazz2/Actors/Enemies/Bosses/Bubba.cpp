@@ -2,6 +2,7 @@
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
+#include "../../ActorPool.h"
 
 #include "../../../../nCine/Base/Random.h"
 
@@ -78,13 +79,13 @@ namespace Jazz2::Actors::Bosses
 						bool spewFileball = (rand < 0.35f);
 						bool tornado = (rand < 0.65f);
 						if (spewFileball) {
-							PlaySfx("Sneeze"_s);
+							RequestSfx("Sneeze"_s);
 
 							SetTransition(AnimState::Shoot, false, [this]() {
 								float x = (IsFacingLeft() ? -16.0f : 16.0f);
 								float y = -5.0f;
 
-								std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+								std::shared_ptr<Fireball> fireball = CreatePooledActor<Fireball>();
 								uint8_t fireballParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 								fireball->OnActivated({
 									.LevelHandler = _levelHandler,
@@ -191,7 +192,7 @@ namespace Jazz2::Actors::Bosses
 
 			_internalForceY = -1.27f;
 
-			PlaySfx("Jump"_s);
+			RequestSfx("Jump"_s);
 
 			SetTransition((AnimState)1073741825, false);
 			SetAnimation(AnimState::Jump);
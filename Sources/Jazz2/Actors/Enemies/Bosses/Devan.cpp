@@ -2,6 +2,7 @@
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
+#include "../../ActorPool.h"
 
 #include "../../../../nCine/Base/Random.h"
 
@@ -181,9 +182,9 @@ namespace Jazz2::Actors::Bosses
 			case StateDemonSpewingFireball: {
 				_state = StateTransition;
 				SetTransition((AnimState)673, false, [this]() {
-					PlaySfx("SpitFireball"_s);
+					RequestSfx("SpitFireball"_s);
 
-					std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+					std::shared_ptr<Fireball> fireball = CreatePooledActor<Fireball>();
 					uint8_t fireballParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 					fireball->OnActivated({
 						.LevelHandler = _levelHandler,
@@ -318,10 +319,10 @@ namespace Jazz2::Actors::Bosses
 
 	void Devan::Shoot()
 	{
-		PlaySfx("Shoot"_s);
+		RequestSfx("Shoot"_s);
 
 		SetTransition((AnimState)16, false, [this]() {
-			std::shared_ptr<Bullet> bullet = std::make_shared<Bullet>();
+			std::shared_ptr<Bullet> bullet = CreatePooledActor<Bullet>();
 			uint8_t fireballParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 			bullet->OnActivated({
 				.LevelHandler = _levelHandler,
@@ -390,19 +391,19 @@ namespace Jazz2::Actors::Bosses
 
 	void Devan::Bullet::OnHitFloor(float timeMult)
 	{
-		PlaySfx("WallPoof"_s);
+		RequestSfx("WallPoof"_s);
 		DecreaseHealth(INT32_MAX);
 	}
 
 	void Devan::Bullet::OnHitWall(float timeMult)
 	{
-		PlaySfx("WallPoof"_s);
+		RequestSfx("WallPoof"_s);
 		DecreaseHealth(INT32_MAX);
 	}
 
 	void Devan::Bullet::OnHitCeiling(float timeMult)
 	{
-		PlaySfx("WallPoof"_s);
+		RequestSfx("WallPoof"_s);
 		DecreaseHealth(INT32_MAX);
 	}
 
@@ -443,7 +444,7 @@ namespace Jazz2::Actors::Bosses
 	{
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X + _speed.X), (int)(_pos.Y + _speed.Y), _renderer.layer() + 2), Explosion::Type::SmallDark);
 
-		PlaySfx("Flap"_s);
+		RequestSfx("Flap"_s);
 
 		return EnemyBase::OnPerish(collider);
 	}
@@ -2,6 +2,7 @@
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Environment/Spring.h"
+#include "../../ActorPool.h"
 
 #include "../../../../nCine/Base/Random.h"
 
@@ -108,7 +109,7 @@ namespace Jazz2::Actors::Bosses
 					SetState(ActorState::IsInvulnerable, false);
 
 					_state = StateScreaming;
-					PlaySfx("Scream"_s);
+					RequestSfx("Scream"_s);
 					SetTransition((AnimState)1073741824, false, [this]() {
 						_state = (Random().NextFloat() < 0.8f ? StateIdleToStomp : StateIdleToBackstep);
 						_stateTime = Random().NextFloat(65.0f, 85.0f);
@@ -127,7 +128,7 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					_state = StateTransition;
 					SetTransition((AnimState)1073741825, false, [this]() {
-						PlaySfx("Stomp"_s);
+						RequestSfx("Stomp"_s);
 
 						SetTransition((AnimState)1073741830, false, [this]() {
 							_state = StateIdleToBackstep;
@@ -136,7 +137,7 @@ namespace Jazz2::Actors::Bosses
 							auto& players = _levelHandler->GetPlayers();
 							auto player = players[Random().Next(0, players.size())];
 
-							std::shared_ptr<Brick> brick = std::make_shared<Brick>();
+							std::shared_ptr<Brick> brick = CreatePooledActor<Brick>();
 							brick->OnActivated({
 								.LevelHandler = _levelHandler,
 								.Pos = Vector3i((int)(player->GetPos().X + Random().NextFloat(-50.0f, 50.0f)), (int)(_pos.Y - 200.0f), _renderer.layer() - 20)
@@ -247,7 +248,7 @@ namespace Jazz2::Actors::Bosses
 				SetState(ActorState::CanJump, false);
 
 				SetAnimation(AnimState::Fall);
-				PlaySfx("Spring"_s);
+				RequestSfx("Spring"_s);
 
 				StringView text = _levelHandler->GetLevelText(_endText, -1, '|');
 				_levelHandler->ShowLevelText(text);
@@ -270,7 +271,7 @@ namespace Jazz2::Actors::Bosses
 		async_await RequestMetadataAsync("Boss/Queen"_s);
 		SetAnimation((AnimState)1073741829);
 
-		PlaySfx("BrickFalling"_s, 0.3f);
+		RequestSfx("BrickFalling"_s, 0.3f);
 
 		async_return true;
 	}
@@ -2,6 +2,7 @@
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
+#include "../../ActorPool.h"
 
 #include "../../../../nCine/Base/Random.h"
 
@@ -91,7 +92,7 @@ namespace Jazz2::Actors::Bosses
 					_speed.X = 0.0f;
 
 					_state = StateTransition;
-					PlaySfx("AttackStart"_s);
+					RequestSfx("AttackStart"_s);
 					SetAnimation(AnimState::Idle);
 					SetTransition((AnimState)1073741824, false, [this]() {
 						_shots = Random().Next(1, 4);
@@ -126,7 +127,7 @@ namespace Jazz2::Actors::Bosses
 			CreateSpriteDebris(Shrapnels[Random().Fast(0, _countof(Shrapnels))], 1);
 		}
 
-		PlaySfx("Shrapnel"_s);
+		RequestSfx("Shrapnel"_s);
 	}
 
 	bool Robot::OnPerish(ActorBase* collider)
@@ -171,7 +172,7 @@ namespace Jazz2::Actors::Bosses
 			_speed.X = (IsFacingLeft() ? -3.0f : 3.0f) * mult;
 			_renderer.AnimDuration = _currentAnimation->AnimDuration / mult;
 
-			PlaySfx("Run"_s);
+			RequestSfx("Run"_s);
 			SetAnimation(AnimState::Run);
 		}
 	}
@@ -182,7 +183,7 @@ namespace Jazz2::Actors::Bosses
 			return;
 		}
 
-		std::shared_ptr<SpikeBall> spikeBall = std::make_shared<SpikeBall>();
+		std::shared_ptr<SpikeBall> spikeBall = CreatePooledActor<SpikeBall>();
 		uint8_t spikeBallParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 		spikeBall->OnActivated({
 			.LevelHandler = _levelHandler,
@@ -193,10 +194,10 @@ namespace Jazz2::Actors::Bosses
 
 		_shots--;
 
-		PlaySfx("Attack"_s);
+		RequestSfx("Attack"_s);
 		SetTransition((AnimState)1073741825, false, [this]() {
 			if (_shots > 0) {
-				PlaySfx("AttackShutter"_s);
+				RequestSfx("AttackShutter"_s);
 				Shoot();
 			} else {
 				Run();
@@ -210,7 +211,7 @@ namespace Jazz2::Actors::Bosses
 			return;
 		}
 
-		PlaySfx("AttackEnd"_s);
+		RequestSfx("AttackEnd"_s);
 		SetTransition((AnimState)1073741826, false, [this]() {
 			_state = StatePreparingToRun;
 			_stateTime = 10.0f;
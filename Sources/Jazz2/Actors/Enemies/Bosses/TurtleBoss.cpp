@@ -78,7 +78,7 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					_speed.X = 0.0f;
 
-					PlaySfx("AttackStart"_s);
+					RequestSfx("AttackStart"_s);
 
 					_state = StateTransition;
 					SetAnimation(AnimState::Idle);
@@ -129,7 +129,7 @@ namespace Jazz2::Actors::Bosses
 					_mace->DecreaseHealth(INT32_MAX);
 					_mace = nullptr;
 
-					PlaySfx("AttackEnd"_s);
+					RequestSfx("AttackEnd"_s);
 
 					SetTransition((AnimState)1073741826, false, [this]() {
 						FollowNearestPlayer(StateWalking1, Random().NextFloat(80.0f, 160.0f));
@@ -108,7 +108,7 @@ namespace Jazz2::Actors::Bosses
 		switch (_state) {
 			case StateOpen: {
 				if (_stateTime <= 0.0f) {
-					PlaySfx("Closing"_s);
+					RequestSfx("Closing"_s);
 
 					_state = StateTransition;
 					SetAnimation((AnimState)1073741825);
@@ -141,7 +141,7 @@ namespace Jazz2::Actors::Bosses
 
 			case StateClosed: {
 				if (_stateTime <= 0.0f) {
-					PlaySfx("Opening"_s);
+					RequestSfx("Opening"_s);
 
 					_state = StateTransition;
 					SetAnimation(AnimState::Idle);
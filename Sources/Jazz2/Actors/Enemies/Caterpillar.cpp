@@ -4,6 +4,7 @@
 #include "../../Tiles/TileMap.h"
 #include "../Player.h"
 #include "../Weapons/ShotBase.h"
+#include "../ActorPool.h"
 
 #include "../../../nCine/Base/Random.h"
 
@@ -69,7 +70,7 @@ namespace Jazz2::Actors::Enemies
 
 					SetAnimation((AnimState)5);
 					SetTransition((AnimState)4, true, [this]() {
-						std::shared_ptr<Smoke> smoke = std::make_shared<Smoke>();
+						std::shared_ptr<Smoke> smoke = CreatePooledActor<Smoke>();
 						smoke->OnActivated({
 							.LevelHandler = _levelHandler,
 							.Pos = Vector3i((int)_pos.X - 26, (int)_pos.Y - 18, _renderer.layer() + 20),
@@ -155,7 +156,7 @@ namespace Jazz2::Actors::Enemies
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (player->SetDizzyTime(180.0f)) {
 				// TODO: Add fade-out
-				PlaySfx("Dizzy"_s);
+				RequestSfx("Dizzy"_s);
 			}
 		}
 
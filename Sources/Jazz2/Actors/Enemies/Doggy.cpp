@@ -76,7 +76,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (_noiseCooldown <= 0.0f) {
 				_noiseCooldown = Random().NextFloat(100, 300);
-				PlaySfx("Noise"_s, 0.4f);
+				RequestSfx("Noise"_s, 0.4f);
 			} else {
 				_noiseCooldown -= timeMult;
 			}
@@ -85,7 +85,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (_noiseCooldown <= 0.0f) {
 				_noiseCooldown = Random().NextFloat(25, 40);
-				PlaySfx("Woof"_s);
+				RequestSfx("Woof"_s);
 			} else {
 				_noiseCooldown -= timeMult;
 			}
@@ -124,7 +124,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (dynamic_cast<Weapons::FreezerShot*>(shotBase) == nullptr) {
 				if (_attackTime <= 0.0f) {
-					PlaySfx("Attack");
+					RequestSfx("Attack");
 					_speed.X = (IsFacingLeft() ? -1.0f : 1.0f) * _attackSpeed;
 					SetAnimation(AnimState::TransitionAttack);
 				}
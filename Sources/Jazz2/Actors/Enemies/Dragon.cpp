@@ -4,6 +4,7 @@
 #include "../../Tiles/TileMap.h"
 #include "../Explosion.h"
 #include "../Player.h"
+#include "../ActorPool.h"
 
 #include "../../../nCine/Base/Random.h"
 
@@ -87,7 +88,7 @@ namespace Jazz2::Actors::Enemies
 						});
 					} else {
 						if (_attackTime <= 0.0f) {
-							std::shared_ptr<Fire> fire = std::make_shared<Fire>();
+							std::shared_ptr<Fire> fire = CreatePooledActor<Fire>();
 							uint8_t fireParams[1];
 							fireParams[0] = (IsFacingLeft() ? 1 : 0);
 							fire->OnActivated({
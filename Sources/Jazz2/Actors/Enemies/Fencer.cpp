@@ -53,7 +53,7 @@ namespace Jazz2::Actors::Enemies
 				}
 				_speed.Y = -4.5f;
 
-				PlaySfx("Attack"_s);
+				RequestSfx("Attack"_s);
 
 				SetTransition(AnimState::TransitionAttack, false, [this]() {
 					_speed.X = 0.0f;
@@ -91,7 +91,7 @@ namespace Jazz2::Actors::Enemies
 			_stateTime -= timeMult;
 
 			if (Random().NextFloat() < 0.008f * timeMult) {
-				PlaySfx("Idle"_s, 0.2f);
+				RequestSfx("Idle"_s, 0.2f);
 			}
 		}
 	}
@@ -144,7 +144,7 @@ namespace Jazz2::Actors::Enemies
 			}
 
 			if (Random().NextFloat() < 0.004f * timeMult) {
-				PlaySfx("Noise"_s, 0.2f);
+				RequestSfx("Noise"_s, 0.2f);
 			}
 
 			if (_canIdle) {
@@ -184,6 +184,6 @@ namespace Jazz2::Actors::Enemies
 		_isAttacking = true;
 		SetState(ActorState::CanJump, false);
 
-		PlaySfx("Attack"_s);
+		RequestSfx("Attack"_s);
 	}
 }
\ No newline at end of file
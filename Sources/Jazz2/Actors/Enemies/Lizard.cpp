@@ -104,7 +104,7 @@ namespace Jazz2::Actors::Enemies
 		}
 
 		if (Random().NextFloat() < 0.002f * timeMult) {
-			PlaySfx("Noise"_s, 0.4f);
+			RequestSfx("Noise"_s, 0.4f);
 		}
 	}
 
@@ -7,6 +7,7 @@
 #include "../Environment/Bomb.h"
 #include "../Environment/Copter.h"
 #include "../Player.h"
+#include "../ActorPool.h"
 
 #include "../../../nCine/Base/Random.h"
 #include "../../../nCine/Base/FrameTimer.h"
@@ -117,7 +118,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (distance < 280.0f && _attackTime <= 0.0f) {
 				SetTransition(AnimState::TransitionAttack, false, [this]() {
-					std::shared_ptr<Environment::Bomb> bomb = std::make_shared<Environment::Bomb>();
+					std::shared_ptr<Environment::Bomb> bomb = CreatePooledActor<Environment::Bomb>();
 					uint8_t bombParams[2];
 					bombParams[0] = (uint8_t)(_theme + 1);
 					bombParams[1] = (IsFacingLeft() ? 1 : 0);
@@ -3,6 +3,7 @@
 #include "../../ILevelHandler.h"
 #include "../../Tiles/TileMap.h"
 #include "../Player.h"
+#include "../ActorPool.h"
 
 #include "../../../nCine/Base/Random.h"
 
@@ -57,9 +58,9 @@ namespace Jazz2::Actors::Enemies
 
 						SetAnimation((AnimState)1073741824);
 						SetTransition((AnimState)1073741824, false, [this]() {
-							PlaySfx("Spit"_s);
+							RequestSfx("Spit"_s);
 
-							std::shared_ptr<BulletSpit> bulletSpit = std::make_shared<BulletSpit>();
+							std::shared_ptr<BulletSpit> bulletSpit = CreatePooledActor<BulletSpit>();
 							uint8_t bulletSpitParams[1];
 							bulletSpitParams[0] = (IsFacingLeft() ? 1 : 0);
 							bulletSpit->OnActivated({
@@ -4,6 +4,7 @@
 #include "../../Tiles/TileMap.h"
 #include "../Explosion.h"
 #include "../Player.h"
+#include "../ActorPool.h"
 
 #include "../../../nCine/Base/Random.h"
 
@@ -97,7 +98,7 @@ namespace Jazz2::Actors::Enemies
 							SetFacingLeft(targetPos.X < _pos.X);
 
 							SetTransition((AnimState)1073741826, false, [this]() {
-								std::shared_ptr<Banana> banana = std::make_shared<Banana>();
+								std::shared_ptr<Banana> banana = CreatePooledActor<Banana>();
 								uint8_t bananaParams[1];
 								bananaParams[0] = (IsFacingLeft() ? 1 : 0);
 								banana->OnActivated({
@@ -121,7 +122,7 @@ namespace Jazz2::Actors::Enemies
 						SetFacingLeft(targetPos.X < _pos.X);
 
 						SetTransition((AnimState)1073741826, false, [this]() {
-							std::shared_ptr<Banana> banana = std::make_shared<Banana>();
+							std::shared_ptr<Banana> banana = CreatePooledActor<Banana>();
 							uint8_t bananaParams[1];
 							bananaParams[0] = (IsFacingLeft() ? 1 : 0);
 							banana->OnActivated({
@@ -183,7 +184,7 @@ namespace Jazz2::Actors::Enemies
 			EnemyBase::OnPerish(collider);
 		});
 
-		PlaySfx("BananaSplat"_s, 0.6f);
+		RequestSfx("BananaSplat"_s, 0.6f);
 
 		return false;
 	}
@@ -73,7 +73,7 @@ namespace Jazz2::Actors::Enemies
 				_noiseCooldown = Random().FastFloat(300.0f, 600.0f);
 
 				if (Random().NextFloat() < 0.5f) {
-					PlaySfx("Noise"_s, 0.7f);
+					RequestSfx("Noise"_s, 0.7f);
 				}
 			}
 		}
@@ -140,7 +140,7 @@ namespace Jazz2::Actors::Enemies
 			}
 		}
 
-		PlaySfx("Die"_s);
+		RequestSfx("Die"_s);
 		TryGenerateRandomDrop();
 
 		return EnemyBase::OnPerish(collider);
@@ -169,7 +169,7 @@ namespace Jazz2::Actors::Enemies
 				_attackTime = 80.0f;
 				_attacking = true;
 
-				PlaySfx("Attack"_s, 0.7f);
+				RequestSfx("Attack"_s, 0.7f);
 			});
 		}
 	}
@@ -45,7 +45,7 @@ namespace Jazz2::Actors::Enemies
 			if (parentLastHitDir == LastHitDirection::Left || parentLastHitDir == LastHitDirection::Right) {
 				_speed.X = 3 * (parentLastHitDir == LastHitDirection::Left ? -1 : 1);
 			}
-			PlaySfx("Deflate"_s);
+			RequestSfx("Deflate"_s);
 		} else {
 			SetAnimation(AnimState::Walk);
 
@@ -86,11 +86,11 @@ namespace Jazz2::Actors::Enemies
 				}
 
 				if (_cycle == 0) {
-					PlaySfx("Walk1"_s, 0.2f);
+					RequestSfx("Walk1"_s, 0.2f);
 				} else if (_cycle == 6) {
-					PlaySfx("Walk2"_s, 0.2f);
+					RequestSfx("Walk2"_s, 0.2f);
 				} else if (_cycle == 2 || _cycle == 7) {
-					PlaySfx("Walk3"_s, 0.2f);
+					RequestSfx("Walk3"_s, 0.2f);
 				}
 
 				if ((_cycle >= 4 && _cycle < 7) || _cycle >= 9) {
@@ -79,7 +79,7 @@ namespace Jazz2::Actors::Enemies
 				_isTurning = true;
 				_canHurtPlayer = false;
 				_speed.X = 0;
-				PlaySfx("Withdraw"_s, 0.2f);
+				RequestSfx("Withdraw"_s, 0.2f);
 			}
 		}
 
@@ -155,7 +155,7 @@ namespace Jazz2::Actors::Enemies
 				SetTransition(AnimState::TransitionWithdrawEnd, false, [this]() {
 				   HandleTurn(false);
 				});
-				PlaySfx("WithdrawEnd"_s, 0.2f);
+				RequestSfx("WithdrawEnd"_s, 0.2f);
 				_isWithdrawn = true;
 			} else {
 				_canHurtPlayer = true;
@@ -170,14 +170,14 @@ namespace Jazz2::Actors::Enemies
 	{
 		_speed.X = 0;
 		_isAttacking = true;
-		PlaySfx("Attack"_s);
+		RequestSfx("Attack"_s);
 
 		SetTransition(AnimState::TransitionAttack, false, [this]() {
 			_speed.X = (IsFacingLeft() ? -1 : 1) * DefaultSpeed;
 			_isAttacking = false;
 
 			// TODO: Bad timing
-			PlaySfx("Attack2"_s);
+			RequestSfx("Attack2"_s);
 		});
 	}
 }
\ No newline at end of file
@@ -71,7 +71,7 @@ namespace Jazz2::Actors::Enemies
 		_health = 8;
 
 		if (std::abs(_speed.X) > 0.0f || std::abs(_externalForce.Y) > 0.0f) {
-			PlaySfx("Fly"_s);
+			RequestSfx("Fly"_s);
 			StartBlinking();
 		}
 
@@ -146,7 +146,7 @@ namespace Jazz2::Actors::Enemies
 
 				_speed.X = std::max(4.0f, std::abs(shotSpeed)) * (shotSpeed < 0.0f ? -0.5f : 0.5f);
 
-				PlaySfx("Fly"_s);
+				RequestSfx("Fly"_s);
 			}
 		} else if (auto shell = dynamic_cast<TurtleShell*>(other.get())) {
 			auto otherSpeed = shell->GetSpeed();
@@ -161,7 +161,7 @@ namespace Jazz2::Actors::Enemies
 				_speed.X = totalSpeed / 2.0f * (_speed.X < 0.0f ? 1.0f : -1.0f);
 
 				shell->DecreaseHealth(1, this);
-				PlaySfx("ImpactShell"_s, 0.8f);
+				RequestSfx("ImpactShell"_s, 0.8f);
 				return true;
 			}
 		} else if (auto enemyBase = dynamic_cast<EnemyBase*>(other.get())) {
@@ -204,7 +204,7 @@ namespace Jazz2::Actors::Enemies
 	void TurtleShell::OnHitFloor(float timeMult)
 	{
 		if (std::abs(_speed.Y) > 1.0f) {
-			PlaySfx("ImpactGround"_s);
+			RequestSfx("ImpactGround"_s);
 		}
 	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../../Tiles/TileMap.h"
 #include "../Player.h"
 #include "../Explosion.h"
+#include "../ActorPool.h"
 
 #include "../../../nCine/Base/Random.h"
 
@@ -74,12 +75,12 @@ namespace Jazz2::Actors::Enemies
 			if (_attackTime <= 0.0f && length < 260.0f) {
 				_attackTime = 450.0f;
 
-				PlaySfx("MagicFire"_s);
+				RequestSfx("MagicFire"_s);
 
 				SetTransition(AnimState::TransitionAttack, true, [this]() {
 					Vector2f bulletPos = Vector2f(_pos.X + (IsFacingLeft() ? -24.0f : 24.0f), _pos.Y);
 
-					std::shared_ptr<MagicBullet> magicBullet = std::make_shared<MagicBullet>(this);
+					std::shared_ptr<MagicBullet> magicBullet = CreatePooledActor<MagicBullet>(this);
 					magicBullet->OnActivated({
 						.LevelHandler = _levelHandler,
 						.Pos = Vector3i((int)bulletPos.X, (int)bulletPos.Y, _renderer.layer() + 1)
@@ -137,7 +138,7 @@ namespace Jazz2::Actors::Enemies
 		_speed.X = (IsFacingLeft() ? -9.0f : 9.0f);
 		_speed.Y = -0.8f;
 
-		PlaySfx("Laugh"_s);
+		RequestSfx("Laugh"_s);
 	}
 
 	Task<bool> Witch::MagicBullet::OnActivatedAsync(const ActorActivationDetails& details)
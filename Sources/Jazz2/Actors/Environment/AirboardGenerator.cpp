@@ -19,6 +19,8 @@ namespace Jazz2::Actors::Environment
 		_delay = details.Params[0];
 		_active = true;
 
+		SetState(ActorState::AlwaysFullUpdate, true);
+
 		async_await RequestMetadataAsync("Object/Airboard"_s);
 
 		SetAnimation("Airboard"_s);
@@ -112,7 +112,7 @@ namespace Jazz2::Actors::Environment
 	{
 		ActorBase::OnAnimationFinished();
 
-		PlaySfx("Fly"_s, 0.3f);
+		RequestSfx("Fly"_s, 0.3f);
 	}
 
 	bool Bird::OnHandleCollision(std::shared_ptr<ActorBase> other)
@@ -180,7 +180,7 @@ namespace Jazz2::Actors::Environment
 							shot2->OnFire(sharedOwner, _pos, _speed, IsFacingLeft() ? -0.18f : 0.18f, IsFacingLeft());
 							_levelHandler->AddActor(shot2);
 
-							PlaySfx("Fire"_s, 0.5f);
+							RequestSfx("Fire"_s, 0.5f);
 							_fireCooldown = 48.0f;
 						//}
 						//SetState(ActorState::CollideWithTileset, false);
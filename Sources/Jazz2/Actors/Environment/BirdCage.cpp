@@ -88,7 +88,7 @@ namespace Jazz2::Actors::Environment
 		SetState(ActorState::CollideWithSolidObjects | ActorState::IsSolidObject, false);
 		SetAnimation(AnimState::Activated);
 
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X - 12.0f), (int)(_pos.Y - 6.0f), _renderer.layer() + 90), Explosion::Type::SmokeBrown);
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X - 8.0f), (int)(_pos.Y + 28.0f), _renderer.layer() + 90), Explosion::Type::SmokeBrown);
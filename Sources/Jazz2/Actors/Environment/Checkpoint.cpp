@@ -65,7 +65,7 @@ namespace Jazz2::Actors::Environment
 			SetAnimation("Opened"_s);
 			SetTransition(AnimState::TransitionActivate, false);
 
-			PlaySfx("TransitionActivate"_s);
+			RequestSfx("TransitionActivate"_s);
 
 			// Deactivate event in map
 			uint8_t playerParams[16] = { _theme, 1 };
@@ -68,7 +68,7 @@ namespace Jazz2::Actors::Environment
 				if (player->SetModifier(Player::Modifier::LizardCopter, shared_from_this())) {
 					_state = State::Mounted;
 
-					PlaySfx("CopterPre"_s);
+					RequestSfx("CopterPre"_s);
 					_noise = PlaySfx("Copter"_s, 0.8f, 0.8f);
 					if (_noise != nullptr) {
 						_noise->setLooping(true);
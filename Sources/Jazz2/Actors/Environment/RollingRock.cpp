@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Environment
 
 					if (_soundCooldown <= 0.0f) {
 						_soundCooldown = 140.0f;
-						PlaySfx("Hit"_s, 0.6f, 0.4f);
+						RequestSfx("Hit"_s, 0.6f, 0.4f);
 					}
 				}
 			}
@@ -96,7 +96,7 @@ namespace Jazz2::Actors::Environment
 
 				if (_soundCooldown <= 0.0f) {
 					_soundCooldown = 140.0f;
-					PlaySfx("Hit"_s, 0.6f, 0.4f);
+					RequestSfx("Hit"_s, 0.6f, 0.4f);
 				}
 			}
 
@@ -160,7 +160,7 @@ namespace Jazz2::Actors::Environment
 
 				if (_soundCooldown <= 0.0f) {
 					_soundCooldown = 140.0f;
-					PlaySfx("Hit"_s, 0.6f, 0.4f);
+					RequestSfx("Hit"_s, 0.6f, 0.4f);
 				}
 			}
 		}
@@ -21,14 +21,14 @@ namespace Jazz2::Actors::Environment
 		SetTransition(_currentAnimationState | (AnimState)0x200, false);
 		switch (_orientation) {
 			case 0: // Bottom
-				PlaySfx("Vertical"_s);
+				RequestSfx("Vertical"_s);
 				return Vector2f(0, -_strength);
 			case 2: // Top
-				PlaySfx("VerticalReversed"_s);
+				RequestSfx("VerticalReversed"_s);
 				return Vector2f(0, _strength);
 			case 1: // Right
 			case 3: // Left
-				PlaySfx("Horizontal"_s);
+				RequestSfx("Horizontal"_s);
 				return Vector2f(_strength * (_orientation == 1 ? 1 : -1), 0);
 			default:
 				return Vector2f::Zero;
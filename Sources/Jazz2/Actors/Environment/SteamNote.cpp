@@ -21,7 +21,7 @@ namespace Jazz2::Actors::Environment
 
 		SetAnimation("SteamNote"_s);
 
-		PlaySfx("Appear"_s, 0.4f);
+		RequestSfx("Appear"_s, 0.4f);
 
 		async_return true;
 	}
@@ -35,7 +35,7 @@ namespace Jazz2::Actors::Environment
 				_renderer.AnimPaused = false;
 				_renderer.setDrawEnabled(true);
 
-				PlaySfx("Appear"_s, 0.4f);
+				RequestSfx("Appear"_s, 0.4f);
 			}
 		}
 	}
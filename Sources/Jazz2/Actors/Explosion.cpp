@@ -1,4 +1,5 @@
 ﻿#include "Explosion.h"
+#include "ActorPool.h"
 #include "../ILevelHandler.h"
 
 #include "../../nCine/Base/Random.h"
@@ -16,7 +17,7 @@ namespace Jazz2::Actors
 
 	void Explosion::Create(ILevelHandler* levelHandler, const Vector3i& pos, Type type)
 	{
-		std::shared_ptr<Explosion> explosion = std::make_shared<Explosion>();
+		std::shared_ptr<Explosion> explosion = CreatePooledActor<Explosion>();
 		uint8_t explosionParams[2];
 		*(uint16_t*)&explosionParams[0] = (uint16_t)type;
 		explosion->OnActivated({
@@ -3,6 +3,7 @@
 #include "../Events/EventMap.h"
 #include "../Tiles/TileMap.h"
 #include "../PreferencesCache.h"
+#include "ActorPool.h"
 #include "SolidObjectBase.h"
 #include "Explosion.h"
 #include "PlayerCorpse.h"
@@ -111,7 +112,7 @@ namespace Jazz2::Actors
 
 		_weaponAmmo[(int)WeaponType::Blaster] = UINT16_MAX;
 
-		SetState(ActorState::CollideWithTilesetReduced | ActorState::CollideWithSolidObjects | ActorState::IsSolidObject, true);
+		SetState(ActorState::CollideWithTilesetReduced | ActorState::CollideWithSolidObjects | ActorState::IsSolidObject | ActorState::AlwaysFullUpdate, true);
 
 		_health = 5;
 		_maxHealth = _health;
@@ -624,8 +625,8 @@ namespace Jazz2::Actors
 							_speed.Y = 9.0f;
 							SetState(ActorState::ApplyGravitation, true);
 							SetAnimation(AnimState::Buttstomp);
-							PlaySfx("Buttstomp"_s, 1.0f, 0.8f);
-							PlaySfx("Buttstomp2"_s);
+							RequestSfx("Buttstomp"_s, 1.0f, 0.8f);
+							RequestSfx("Buttstomp2"_s);
 						});
 					}
 				}
@@ -644,7 +645,7 @@ namespace Jazz2::Actors
 						if (_isLifting && GetState(ActorState::CanJump) && _currentSpecialMove == SpecialMoveType::None) {
 							SetState(ActorState::CanJump, false);
 							SetAnimation(_currentAnimationState & (~AnimState::Lookup & ~AnimState::Crouch));
-							PlaySfx("Jump"_s);
+							RequestSfx("Jump"_s);
 							_carryingObject = nullptr;
 
 							SetState(ActorState::IsSolidObject | ActorState::CollideWithSolidObjects, false);
@@ -712,7 +713,7 @@ namespace Jazz2::Actors
 											_speed.Y = -0.6f - std::max(0.0f, (std::abs(_speed.X) - 4.0f) * 0.3f);
 											_speed.X *= 0.4f;
 
-											PlaySfx("DoubleJump"_s);
+											RequestSfx("DoubleJump"_s);
 
 											SetTransition(AnimState::Spring, false);
 										}
@@ -771,7 +772,7 @@ namespace Jazz2::Actors
 						_isFreefall = false;
 						SetAnimation(_currentAnimationState & (~AnimState::Lookup & ~AnimState::Crouch));
 						if (_jumpTime <= 0.0f) {
-							PlaySfx("Jump"_s);
+							RequestSfx("Jump"_s);
 						}
 						_jumpTime = 12.0f;
 						_carryingObject = nullptr;
@@ -802,7 +803,7 @@ namespace Jazz2::Actors
 			if (!_isLifting && _suspendType != SuspendType::SwingingVine && (_currentAnimationState & AnimState::Push) != AnimState::Push && _pushFramesLeft <= 0.0f) {
 				if (_playerType == PlayerType::Frog) {
 					if (_currentTransitionState == AnimState::Idle && std::abs(_speed.X) < 0.1f && std::abs(_speed.Y) < 0.1f && std::abs(_externalForce.X) < 0.1f && std::abs(_externalForce.Y) < 0.1f) {
-						PlaySfx("Tongue"_s, 0.8f);
+						RequestSfx("Tongue"_s, 0.8f);
 
 						_controllable = false;
 						_controllableTimeout = 120.0f;
@@ -1040,7 +1041,7 @@ namespace Jazz2::Actors
 						_isSpring = true;
 					}
 
-					PlaySfx("Spring"_s);
+					RequestSfx("Spring"_s);
 				}
 			}
 
@@ -1057,7 +1058,7 @@ namespace Jazz2::Actors
 					_coins = 0;
 				} else if (_bonusWarpTimer <= 0.0f) {
 					_levelHandler->ShowCoins(_coins);
-					PlaySfx("BonusWarpNotEnoughCoins"_s);
+					RequestSfx("BonusWarpNotEnoughCoins"_s);
 
 					_bonusWarpTimer = 400.0f;
 				}
@@ -1080,7 +1081,7 @@ namespace Jazz2::Actors
 			TakeDamage(1, _speed.X * 0.25f);
 		} else if (!_inWater && _activeModifier == Modifier::None) {
 			if (!GetState(ActorState::CanJump)) {
-				PlaySfx("Land"_s, 0.8f);
+				RequestSfx("Land"_s, 0.8f);
 
 				if (Random().NextFloat() < 0.6f) {
 					Explosion::Create(_levelHandler, Vector3i((int)_pos.X, (int)_pos.Y + 20.0f, _renderer.layer() - 2), Explosion::Type::TinyDark);
@@ -1361,7 +1362,7 @@ namespace Jazz2::Actors
 							SetTransition(AnimState::TransitionLedge, true);
 						}
 
-						PlaySfx("Ledge"_s);
+						RequestSfx("Ledge"_s);
 					}
 				}
 				break;
@@ -1543,7 +1544,7 @@ namespace Jazz2::Actors
 				SetState(ActorState::ApplyGravitation, false);
 
 				if (_speed.Y > 0.0f && newSuspendState == SuspendType::Vine) {
-					PlaySfx("HookAttach"_s, 0.8f, 1.2f);
+					RequestSfx("HookAttach"_s, 0.8f, 1.2f);
 				}
 
 				_speed.Y = 0.0f;
@@ -1753,7 +1754,7 @@ namespace Jazz2::Actors
 						_levelHandler->BeginLevelChange(exitType, nextLevel);
 					} else if (_bonusWarpTimer <= 0.0f) {
 						_levelHandler->ShowCoins(_coins);
-						PlaySfx("BonusWarpNotEnoughCoins"_s);
+						RequestSfx("BonusWarpNotEnoughCoins"_s);
 
 						_bonusWarpTimer = 400.0f;
 					}
@@ -2023,7 +2024,7 @@ namespace Jazz2::Actors
 	void Player::SwitchToWeaponByIndex(uint32_t weaponIndex)
 	{
 		if (weaponIndex >= (uint32_t)WeaponType::Count || _weaponAmmo[weaponIndex] == 0) {
-			PlaySfx("ChangeWeapon"_s);
+			RequestSfx("ChangeWeapon"_s);
 			return;
 		}
 
@@ -2045,7 +2046,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<T> shot = std::make_shared<T>();
+		std::shared_ptr<T> shot = CreatePooledActor<T>();
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)weaponType] };
 		shot->OnActivated({
 			.LevelHandler = _levelHandler,
@@ -2068,7 +2069,7 @@ namespace Jazz2::Actors
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)WeaponType::RF] };
 
 		if ((_weaponUpgrades[(int)WeaponType::RF] & 0x1) != 0) {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreatePooledActor<Weapons::RFShot>();
 			shot1->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2077,7 +2078,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreatePooledActor<Weapons::RFShot>();
 			shot2->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2086,7 +2087,7 @@ namespace Jazz2::Actors
 			shot2->OnFire(shared_from_this(), gunspotPos, _speed, angle, IsFacingLeft());
 			_levelHandler->AddActor(shot2);
 
-			std::shared_ptr<Weapons::RFShot> shot3 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot3 = CreatePooledActor<Weapons::RFShot>();
 			shot3->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2095,7 +2096,7 @@ namespace Jazz2::Actors
 			shot3->OnFire(shared_from_this(), gunspotPos, _speed, angle + 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot3);
 		} else {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreatePooledActor<Weapons::RFShot>();
 			shot1->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2104,7 +2105,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.22f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreatePooledActor<Weapons::RFShot>();
 			shot2->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2126,7 +2127,7 @@ namespace Jazz2::Actors
 
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)WeaponType::Pepper] };
 
-		std::shared_ptr<Weapons::PepperShot> shot1 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot1 = CreatePooledActor<Weapons::PepperShot>();
 		shot1->OnActivated({
 			.LevelHandler = _levelHandler,
 			.Pos = initialPos,
@@ -2135,7 +2136,7 @@ namespace Jazz2::Actors
 		shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - Random().NextFloat(-0.2f, 0.2f), IsFacingLeft());
 		_levelHandler->AddActor(shot1);
 
-		std::shared_ptr<Weapons::PepperShot> shot2 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot2 = CreatePooledActor<Weapons::PepperShot>();
 		shot2->OnActivated({
 			.LevelHandler = _levelHandler,
 			.Pos = initialPos,
@@ -2149,7 +2150,7 @@ namespace Jazz2::Actors
 
 	void Player::FireWeaponTNT()
 	{
-		std::shared_ptr<Weapons::TNT> tnt = std::make_shared<Weapons::TNT>();
+		std::shared_ptr<Weapons::TNT> tnt = CreatePooledActor<Weapons::TNT>();
 		tnt->OnActivated({
 			.LevelHandler = _levelHandler,
 			.Pos = Vector3i((int)_pos.X, (int)_pos.Y, _renderer.layer() - 2)
@@ -2172,7 +2173,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<Weapons::Thunderbolt> shot = std::make_shared<Weapons::Thunderbolt>();
+		std::shared_ptr<Weapons::Thunderbolt> shot = CreatePooledActor<Weapons::Thunderbolt>();
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)WeaponType::Thunderbolt] };
 		shot->OnActivated({
 			.LevelHandler = _levelHandler,
@@ -2210,7 +2211,7 @@ namespace Jazz2::Actors
 		switch (weaponType) {
 			case WeaponType::Blaster:
 				FireWeapon<Weapons::BlasterShot, WeaponType::Blaster>(40.0f, 1.0f);
-				PlaySfx("WeaponBlaster"_s);
+				RequestSfx("WeaponBlaster"_s);
 				ammoDecrease = 0;
 				break;
 
@@ -2262,7 +2263,7 @@ namespace Jazz2::Actors
 		// No ammo, switch weapons
 		if (currentAmmo == 0) {
 			SwitchToNextWeapon();
-			PlaySfx("ChangeWeapon"_s);
+			RequestSfx("ChangeWeapon"_s);
 			_weaponCooldown = 20.0f;
 		}
 
@@ -2636,7 +2637,7 @@ namespace Jazz2::Actors
 
 		_controllableTimeout = 80.0f;
 
-		PlaySfx("Pole"_s, 0.8f, 0.6f);
+		RequestSfx("Pole"_s, 0.8f, 0.6f);
 	}
 
 	void Player::NextPoleStage(bool horizontal, bool positive, int stagesLeft, float lastSpeed)
@@ -2654,7 +2655,7 @@ namespace Jazz2::Actors
 
 			_controllableTimeout = 80.0f;
 
-			PlaySfx("Pole"_s, 1.0f, 0.6f);
+			RequestSfx("Pole"_s, 1.0f, 0.6f);
 		} else {
 			int sign = (positive ? 1 : -1);
 			if (horizontal) {
@@ -2686,7 +2687,7 @@ namespace Jazz2::Actors
 			_controllableTimeout = 4.0f;
 			_lastPoleTime = 10.0f;
 
-			PlaySfx("HookAttach"_s, 0.8f, 1.2f);
+			RequestSfx("HookAttach"_s, 0.8f, 1.2f);
 		}
 	}
 
@@ -2817,7 +2818,7 @@ namespace Jazz2::Actors
 				SetInvulnerability(180.0f, false);
 			}
 
-			PlaySfx("Hurt"_s);
+			RequestSfx("Hurt"_s);
 		} else {
 			_externalForce.X = 0.0f;
 			_speed.Y = 0.0f;
@@ -2893,13 +2894,13 @@ namespace Jazz2::Actors
 
 		if (amount < 0) {
 			_health = std::max(_maxHealth, HealthLimit);
-			PlaySfx("PickupMaxCarrot"_s);
+			RequestSfx("PickupMaxCarrot"_s);
 		} else {
 			_health = std::min(_health + amount, HealthLimit);
 			if (_maxHealth < _health) {
 				_maxHealth = _health;
 			}
-			PlaySfx("PickupFood"_s);
+			RequestSfx("PickupFood"_s);
 		}
 
 		return true;
@@ -2909,21 +2910,21 @@ namespace Jazz2::Actors
 	{
 		_lives += count;
 
-		PlaySfx("PickupOneUp"_s);
+		RequestSfx("PickupOneUp"_s);
 	}
 
 	void Player::AddCoins(int count)
 	{
 		_coins += count;
 		_levelHandler->ShowCoins(_coins);
-		PlaySfx("PickupCoin"_s);
+		RequestSfx("PickupCoin"_s);
 	}
 
 	void Player::AddGems(int count)
 	{
 		_gems += count;
 		_levelHandler->ShowGems(_gems);
-		PlaySfx("PickupGem"_s, 1.0f, std::min(0.7f + _gemsPitch * 0.05f, 1.3f));
+		RequestSfx("PickupGem"_s, 1.0f, std::min(0.7f + _gemsPitch * 0.05f, 1.3f));
 
 		_gemsTimer = 120.0f;
 		_gemsPitch++;
@@ -2932,9 +2933,9 @@ namespace Jazz2::Actors
 	void Player::ConsumeFood(bool isDrinkable)
 	{
 		if (isDrinkable) {
-			PlaySfx("PickupDrink"_s);
+			RequestSfx("PickupDrink"_s);
 		} else {
-			PlaySfx("PickupFood"_s);
+			RequestSfx("PickupFood"_s);
 		}
 
 		_foodEaten++;
@@ -2979,7 +2980,7 @@ namespace Jazz2::Actors
 			}
 		}
 
-		PlaySfx("PickupAmmo"_s);
+		RequestSfx("PickupAmmo"_s);
 		return true;
 	}
 
@@ -3001,7 +3002,7 @@ namespace Jazz2::Actors
 
 		_weaponUpgrades[(int)WeaponType::Blaster] = (uint8_t)((_weaponUpgrades[(int)WeaponType::Blaster] & 0x1) | (current << 1));
 
-		PlaySfx("PickupAmmo"_s);
+		RequestSfx("PickupAmmo"_s);
 
 		return true;
 	}
@@ -3053,7 +3054,7 @@ namespace Jazz2::Actors
 
 		// Set transition
 		if (type == PlayerType::Frog) {
-			PlaySfx("Transform");
+			RequestSfx("Transform");
 
 			_controllable = false;
 			_controllableTimeout = 120.0f;
@@ -90,7 +90,7 @@ namespace Jazz2::Actors::Solid
 			}
 		}
 
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		CreateParticleDebris();
 
@@ -77,7 +77,7 @@ namespace Jazz2::Actors::Solid
 
 		CreateParticleDebris();
 
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		if (_content.empty()) {
 			// Random Ammo create
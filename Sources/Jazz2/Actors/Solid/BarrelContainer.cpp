@@ -65,7 +65,7 @@ namespace Jazz2::Actors::Solid
 
 	bool BarrelContainer::OnPerish(ActorBase* collider)
 	{
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		CreateParticleDebris();
 
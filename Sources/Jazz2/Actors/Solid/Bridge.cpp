@@ -175,10 +175,9 @@ namespace Jazz2::Actors::Solid
 				float texScaleY = (float(_currentAnimation->Base->FrameDimensions.Y) / float(texSize.Y));
 				float texBiasY = (float(_currentAnimation->Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_currentAnimation->Base->FrameDimensions.X, _currentAnimation->Base->FrameDimensions.Y);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->material().spriteSizeUniform()->setFloatValue(_currentAnimation->Base->FrameDimensions.X, _currentAnimation->Base->FrameDimensions.Y);
+				command->material().colorUniform()->setFloatVector(Colorf::White.Data());
 
 				auto& pos = _pieces[i].Pos;
 				command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
@@ -65,7 +65,7 @@ namespace Jazz2::Actors::Solid
 
 		CreateParticleDebris();
 
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		CreateSpriteDebris("CrateShrapnel1"_s, 3);
 		CreateSpriteDebris("CrateShrapnel2"_s, 2);
@@ -69,7 +69,7 @@ namespace Jazz2::Actors::Solid
 
 	bool GemBarrel::OnPerish(ActorBase* collider)
 	{
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		CreateParticleDebris();
 
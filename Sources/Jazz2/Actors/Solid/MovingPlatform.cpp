@@ -52,6 +52,7 @@ namespace Jazz2::Actors::Solid
 
 		IsOneWay = true;
 		SetState(ActorState::CollideWithTileset | ActorState::IsSolidObject | ActorState::ApplyGravitation, false);
+		SetState(ActorState::AlwaysFullUpdate, true);
 
 		switch (_type) {
 			default:
@@ -230,10 +231,9 @@ namespace Jazz2::Actors::Solid
 					float texScaleY = (float(chainAnim.Base->FrameDimensions.Y) / float(texSize.Y));
 					float texBiasY = (float(chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(chainAnim.Base->FrameDimensions.X, chainAnim.Base->FrameDimensions.Y);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+					command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->material().spriteSizeUniform()->setFloatValue(chainAnim.Base->FrameDimensions.X, chainAnim.Base->FrameDimensions.Y);
+					command->material().colorUniform()->setFloatVector(Colorf::White.Data());
 
 					auto& pos = _pieces[i].Pos;
 					command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
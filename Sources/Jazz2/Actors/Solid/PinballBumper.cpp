@@ -46,7 +46,7 @@ namespace Jazz2::Actors::Solid
 					_cooldown = 10.0f;
 
 					SetTransition(_currentAnimationState | (AnimState)0x200, true);
-					PlaySfx("Hit"_s, 0.8f);
+					RequestSfx("Hit"_s, 0.8f);
 
 					constexpr float forceMult = 24.0f;
 					Vector2f force = (player->GetPos() - _pos).Normalize() * forceMult;
@@ -96,7 +96,7 @@ namespace Jazz2::Actors::Solid
 			player->MorphTo(playerType.value());
 
 			DecreaseHealth(INT32_MAX, player);
-			PlaySfx("Break"_s);
+			RequestSfx("Break"_s);
 		}
 	}
 
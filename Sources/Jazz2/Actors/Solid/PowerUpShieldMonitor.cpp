@@ -83,6 +83,6 @@ namespace Jazz2::Actors::Solid
 		//player->SetShield(_shieldType, 30.0f);
 
 		DecreaseHealth(INT32_MAX, player);
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 	}
 }
\ No newline at end of file
@@ -101,6 +101,6 @@ namespace Jazz2::Actors::Solid
 		player->AddAmmo(_weaponType, 25);
 
 		DecreaseHealth(INT32_MAX, player);
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 	}
 }
\ No newline at end of file
@@ -28,7 +28,7 @@ namespace Jazz2::Actors::Solid
 		_originPos = _pos;
 		_originLayer = _renderer.layer() - 12;
 
-		SetState(ActorState::IsInvulnerable, true);
+		SetState(ActorState::IsInvulnerable | ActorState::AlwaysFullUpdate, true);
 		SetState(ActorState::CollideWithTileset | ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 
 		async_await RequestMetadataAsync("MovingPlatform/SpikeBall"_s);
@@ -110,13 +110,12 @@ namespace Jazz2::Actors::Solid
 					float texScaleY = (float(chainAnim.Base->FrameDimensions.Y) / float(texSize.Y));
 					float texBiasY = (float(chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(chainAnim.Base->FrameDimensions.X, chainAnim.Base->FrameDimensions.Y);
+					command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->material().spriteSizeUniform()->setFloatValue(chainAnim.Base->FrameDimensions.X, chainAnim.Base->FrameDimensions.Y);
 					if (_shade) {
-						instanceBlock->uniform(Material::ColorUniformName)->setFloatVector((scale < 1.0f ? Colorf(scale, scale, scale, 1.0f) : Colorf::White).Data());
+						command->material().colorUniform()->setFloatVector((scale < 1.0f ? Colorf(scale, scale, scale, 1.0f) : Colorf::White).Data());
 					} else {
-						instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+						command->material().colorUniform()->setFloatVector(Colorf::White.Data());
 					}
 
 					auto& pos = _pieces[i].Pos;
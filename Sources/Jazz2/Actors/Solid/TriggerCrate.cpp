@@ -78,7 +78,7 @@ namespace Jazz2::Actors::Solid
 			}
 		}
 
-		PlaySfx("Break"_s);
+		RequestSfx("Break"_s);
 
 		CreateParticleDebris();
 
@@ -81,7 +81,7 @@ namespace Jazz2::Actors::Weapons
 		ShotBase::OnUpdate(timeMult);
 
 		if (_timeLeft <= 0.0f) {
-			PlaySfx("WallPoof"_s);
+			RequestSfx("WallPoof"_s);
 		}
 
 		if (!_fired) {
@@ -127,7 +127,7 @@ namespace Jazz2::Actors::Weapons
 
 		DecreaseHealth(INT32_MAX);
 
-		PlaySfx("WallPoof"_s);
+		RequestSfx("WallPoof"_s);
 	}
 
 	void BlasterShot::OnRicochet()
@@ -136,6 +136,6 @@ namespace Jazz2::Actors::Weapons
 
 		_renderer.setRotation(atan2f(_speed.Y, _speed.X));
 
-		PlaySfx("Ricochet"_s);
+		RequestSfx("Ricochet"_s);
 	}
 }
\ No newline at end of file
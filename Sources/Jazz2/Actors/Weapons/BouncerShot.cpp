@@ -30,10 +30,10 @@ namespace Jazz2::Actors::Weapons
 		if ((_upgrades & 0x1) != 0) {
 			_timeLeft = 130;
 			state |= (AnimState)1;
-			PlaySfx("FireUpgraded"_s, 1.0f, 0.5f);
+			RequestSfx("FireUpgraded"_s, 1.0f, 0.5f);
 		} else {
 			_timeLeft = 90;
-			PlaySfx("Fire"_s, 1.0f, 0.5f);
+			RequestSfx("Fire"_s, 1.0f, 0.5f);
 		}
 
 		SetAnimation(state);
@@ -121,7 +121,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		_hitLimit += 2.0f;
-		PlaySfx("Bounce"_s, 0.5f);
+		RequestSfx("Bounce"_s, 0.5f);
 	}
 
 	void BouncerShot::OnHitFloor(float timeMult)
@@ -132,7 +132,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		_hitLimit += 2.0f;
-		PlaySfx("Bounce"_s, 0.5f);
+		RequestSfx("Bounce"_s, 0.5f);
 	}
 
 	void BouncerShot::OnHitCeiling(float timeMult)
@@ -143,7 +143,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		_hitLimit += 2.0f;
-		PlaySfx("Bounce"_s, 0.5f);
+		RequestSfx("Bounce"_s, 0.5f);
 	}
 
 	void BouncerShot::OnRicochet()
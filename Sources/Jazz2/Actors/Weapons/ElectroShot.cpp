@@ -31,7 +31,7 @@ namespace Jazz2::Actors::Weapons
 
 		async_await RequestMetadataAsync("Weapon/Electro"_s);
 		SetAnimation(AnimState::Idle);
-		PlaySfx("Fire"_s);
+		RequestSfx("Fire"_s);
 
 		_renderer.setDrawEnabled(false);
 
@@ -32,10 +32,10 @@ namespace Jazz2::Actors::Weapons
 		if ((_upgrades & 0x01) != 0) {
 			_timeLeft = 38;
 			state |= (AnimState)1;
-			PlaySfx("FireUpgraded"_s);
+			RequestSfx("FireUpgraded"_s);
 		} else {
 			_timeLeft = 44;
-			PlaySfx("Fire"_s);
+			RequestSfx("Fire"_s);
 		}
 
 		SetAnimation(state);
@@ -77,7 +77,7 @@ namespace Jazz2::Actors::Weapons
 		// TODO: Add particles
 
 		if (_timeLeft <= 0.0f) {
-			PlaySfx("WallPoof"_s);
+			RequestSfx("WallPoof"_s);
 		}
 
 		if (!_fired) {
@@ -119,6 +119,6 @@ namespace Jazz2::Actors::Weapons
 	{
 		DecreaseHealth(INT32_MAX);
 
-		PlaySfx("WallPoof"_s);
+		RequestSfx("WallPoof"_s);
 	}
 }
\ No newline at end of file
@@ -35,7 +35,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		SetAnimation(state);
-		PlaySfx("Fire"_s);
+		RequestSfx("Fire"_s);
 
 		_renderer.setBlendingPreset(DrawableNode::BlendingPreset::ADDITIVE);
 
@@ -44,7 +44,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		SetAnimation(state);
-		PlaySfx("Fire"_s);
+		RequestSfx("Fire"_s);
 
 		async_return true;
 	}
@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Weapons
 				DecreaseHealth(INT32_MAX);
 			});
 
-			PlaySfx("Explosion"_s);
+			RequestSfx("Explosion"_s);
 
 			_levelHandler->FindCollisionActorsByRadius(_pos.X, _pos.Y, 50.0f, [this](ActorBase* actor) {
 				actor->OnHandleCollision(shared_from_this());
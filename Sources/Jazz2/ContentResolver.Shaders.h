@@ -6,60 +6,17 @@ namespace Jazz2::Shaders
 uniform mat4 uProjectionMatrix;
 uniform mat4 uViewMatrix;
 
-layout (std140) uniform InstanceBlock
-{
-	mat4 modelMatrix;
-	vec4 color;
-	vec4 texRect;
-	vec2 spriteSize;
-};
-
-out vec4 vTexCoords;
-out vec4 vColor;
-
-void main() {
-	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), 0.5 - float(gl_VertexID % 2));
-	vec4 position = vec4(aPosition.x * spriteSize.x, aPosition.y * spriteSize.y, 0.0, 1.0);
-
-	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * position;
-	vTexCoords = texRect;
-	vColor = vec4(color.x, color.y, aPosition.x * 2.0, aPosition.y * 2.0);
-}
-)";
-
-	constexpr char BatchedLightingVs[] = R"(
-uniform mat4 uProjectionMatrix;
-uniform mat4 uViewMatrix;
-
-struct Instance
-{
-	mat4 modelMatrix;
-	vec4 color;
-	vec4 texRect;
-	vec2 spriteSize;
-};
-
-layout (std140) uniform InstancesBlock
-{
-#ifdef WITH_FIXED_BATCH_SIZE
-	Instance[BATCH_SIZE] instances;
-#else
-	Instance[500] instances;
-#endif
-} block;
+in vec2 aPosition;
+in vec2 aTexCoords; // Corner of the light quad in range [-1, 1]
+in vec4 aLight; // Intensity, brightness, near radius relative to the far one, far radius
 
 out vec4 vTexCoords;
 out vec4 vColor;
 
-#define i block.instances[gl_VertexID / 6]
-
 void main() {
-	vec2 aPosition = vec2(-0.5 + float(((gl_VertexID + 2) / 3) % 2), -0.5 + float(((gl_VertexID + 1) / 3) % 2));
-	vec4 position = vec4(aPosition.x * i.spriteSize.x, aPosition.y * i.spriteSize.y, 0.0, 1.0);
-
-	gl_Position = uProjectionMatrix * uViewMatrix * i.modelMatrix * position;
-	vTexCoords = i.texRect;
-	vColor = vec4(i.color.x, i.color.y, aPosition.x * 2.0, aPosition.y * 2.0);
+	gl_Position = uProjectionMatrix * uViewMatrix * vec4(aPosition, 0.0, 1.0);
+	vTexCoords = vec4(aPosition - aTexCoords * aLight.w, aLight.z, 0.0);
+	vColor = vec4(aLight.x, aLight.y, aTexCoords.x, aTexCoords.y);
 }
 )";
 
@@ -107,32 +64,28 @@ void main() {
 }
 )";
 
-	constexpr char BlurFs[] = R"(
+	constexpr char BlurDownsampleFs[] = R"(
 #ifdef GL_ES
 precision mediump float;
 #endif
 
 uniform sampler2D uTexture;
 uniform vec2 uPixelOffset;
-uniform vec2 uDirection;
 
 in vec2 vTexCoords;
 out vec4 fragColor;
 
 void main() {
-	vec4 color = vec4(0.0);
-	vec2 off1 = vec2(1.3846153846) * uPixelOffset * uDirection;
-	vec2 off2 = vec2(3.2307692308) * uPixelOffset * uDirection;
-	color += texture(uTexture, vTexCoords) * 0.2270270270;
-	color += texture(uTexture, vTexCoords + off1) * 0.3162162162;
-	color += texture(uTexture, vTexCoords - off1) * 0.3162162162;
-	color += texture(uTexture, vTexCoords + off2) * 0.0702702703;
-	color += texture(uTexture, vTexCoords - off2) * 0.0702702703;
-	fragColor = color;
+	vec4 color = texture(uTexture, vTexCoords) * 4.0;
+	color += texture(uTexture, vTexCoords - uPixelOffset);
+	color += texture(uTexture, vTexCoords + uPixelOffset);
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, -uPixelOffset.y));
+	color += texture(uTexture, vTexCoords - vec2(uPixelOffset.x, -uPixelOffset.y));
+	fragColor = color * 0.125;
 }
 )";
 
-	constexpr char DownsampleFs[] = R"(
+	constexpr char BlurUpsampleFs[] = R"(
 #ifdef GL_ES
 precision mediump float;
 #endif
@@ -144,11 +97,15 @@ in vec2 vTexCoords;
 out vec4 fragColor;
 
 void main() {
-	vec4 color = texture(uTexture, vTexCoords);
-	color += texture(uTexture, vTexCoords + vec2(0.0, uPixelOffset.y));
-	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, 0.0));
-	color += texture(uTexture, vTexCoords + uPixelOffset);
-	fragColor = vec4(0.25) * color;
+	vec4 color = texture(uTexture, vTexCoords + vec2(-uPixelOffset.x * 2.0, 0.0));
+	color += texture(uTexture, vTexCoords + vec2(-uPixelOffset.x, uPixelOffset.y)) * 2.0;
+	color += texture(uTexture, vTexCoords + vec2(0.0, uPixelOffset.y * 2.0));
+	color += texture(uTexture, vTexCoords + uPixelOffset) * 2.0;
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x * 2.0, 0.0));
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, -uPixelOffset.y)) * 2.0;
+	color += texture(uTexture, vTexCoords + vec2(0.0, -uPixelOffset.y * 2.0));
+	color += texture(uTexture, vTexCoords - uPixelOffset) * 2.0;
+	fragColor = color / 12.0;
 }
 )";
 
@@ -576,6 +533,58 @@ void main() {
 	fragColor = mix(texColor, horizonColorWithStars, horizonOpacity);
 	fragColor.a = 1.0;
 }
+)";
+
+	constexpr char TileLayerFs[] = R"(
+#ifdef GL_ES
+precision highp float;
+precision highp int;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uTileIndices;
+uniform sampler2D uAnimatedTiles;
+
+uniform vec2 uLayerSize;
+uniform vec2 uRepeat;
+uniform float uTilesPerRow;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+void main() {
+	// Texture coordinates are in pixels on the layer
+	vec2 tilePos = floor(vTexCoords / 32.0);
+	vec2 wrappedPos = tilePos - uLayerSize * floor(tilePos / uLayerSize);
+	if ((uRepeat.x < 0.5 && tilePos.x != wrappedPos.x) || (uRepeat.y < 0.5 && tilePos.y != wrappedPos.y)) {
+		discard;
+	}
+
+	// Tile index is packed in RG, flags in B and alpha in A
+	ivec4 tile = ivec4(texelFetch(uTileIndices, ivec2(wrappedPos), 0) * 255.0 + 0.5);
+	int tileId = tile.r + tile.g * 256;
+	if ((tile.b & 4) != 0) {
+		ivec2 animTile = ivec2(texelFetch(uAnimatedTiles, ivec2(tileId, 0), 0).rg * 255.0 + 0.5);
+		tileId = animTile.r + animTile.g * 256;
+	}
+	if (tileId == 0 || tile.a == 0) {
+		discard;
+	}
+
+	ivec2 local = clamp(ivec2(vTexCoords - tilePos * 32.0), ivec2(0), ivec2(31));
+	if ((tile.b & 1) != 0) {
+		local.x = 31 - local.x;
+	}
+	if ((tile.b & 2) != 0) {
+		local.y = 31 - local.y;
+	}
+
+	int tilesPerRow = int(uTilesPerRow);
+	ivec2 texel = ivec2((tileId % tilesPerRow) * 32, (tileId / tilesPerRow) * 32) + local;
+	vec4 color = texelFetch(uTexture, texel, 0);
+	fragColor = vec4(color.rgb, color.a * float(tile.a) / 255.0) * vColor;
+}
 )";
 
 	constexpr char ColorizeFs[] = R"(
@@ -666,6 +675,73 @@ void main() {
 	float color = min((0.299 * tex.r + 0.587 * tex.g + 0.114 * tex.b) * 2.5f, 1.0f);
 	fragColor = vec4(color, color, color, tex.a) * vColor;
 }
+)";
+
+	constexpr char TextVs[] = R"(
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+uniform vec4 uWave; // Phase, angle multiplier, horizontal and vertical variance
+uniform float uWaveAlternate;
+uniform float uScale;
+uniform vec4 uColor; // Base color of the string
+uniform float uInlineAlpha;
+
+layout (std140) uniform InstanceBlock
+{
+	mat4 modelMatrix;
+};
+
+in vec4 aPosition; // Glyph center relative to the text origin, corner offset from the center
+in vec2 aTexCoords;
+in vec4 aColor;
+in vec3 aGlyph; // Character index, colorize flag, color source
+
+out vec2 vTexCoords;
+out vec4 vColor;
+out float vColorize;
+
+void main() {
+	float phase = (uWave.x + aGlyph.x) * uWave.y;
+	if (uWaveAlternate > 0.5 && mod(aGlyph.x, 2.0) >= 1.0) {
+		phase = -phase;
+	}
+
+	vec4 center = modelMatrix * vec4(aPosition.x * uScale + cos(phase) * uWave.z, aPosition.y * uScale - sin(phase) * uWave.w, 0.0, 1.0);
+	// Glyphs are snapped to whole pixels, it looks better with the "0.5" offset
+	center.xy = floor(center.xy + vec2(0.5)) + vec2(0.0, 0.5);
+
+	gl_Position = uProjectionMatrix * uViewMatrix * vec4(center.xy + aPosition.zw * uScale, center.z, 1.0);
+	vTexCoords = aTexCoords;
+	// Color source: 0 - base color, 1 - own color with base alpha, 2 - own color with alpha of inline colors
+	vec3 rgb = (aGlyph.z < 0.5 ? uColor.rgb : aColor.rgb);
+	float alpha = (aGlyph.z < 1.5 ? uColor.a : uInlineAlpha);
+	vColor = vec4(rgb, alpha * aColor.a);
+	vColorize = aGlyph.y;
+}
+)";
+
+	constexpr char TextFs[] = R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+in float vColorize;
+out vec4 fragColor;
+
+void main() {
+	vec4 original = texture(uTexture, vTexCoords);
+
+	// Same as Colorize shader, but it can be enabled per glyph
+	vec4 dye = vec4(1.0) + (vColor - vec4(0.5)) * vec4(4.0);
+	float average = (original.r + original.g + original.b) * 0.5;
+	vec4 colorized = vec4(average, average, average, original.a) * dye;
+
+	fragColor = mix(original * vColor, colorized, vColorize);
+}
 )";
 
 	constexpr char ResizeHQ2xVs[] = R"(
@@ -1630,5 +1706,40 @@ void main() {
 	float noise = 1.0 + rand(uv) * 0.1;
 	fragColor = vec4(0.0, 0.0, 0.0, mixValue * noise);
 }
+)";
+
+	constexpr char CinematicsFs[] = R"(
+#ifdef GL_ES
+precision highp float;
+precision highp int;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uPalette;
+
+uniform vec2 uFrameSize;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+vec3 lookup(ivec2 pos) {
+	// Texture contains palette indices, colors are looked up in 256x1 palette texture
+	int index = int(texelFetch(uTexture, pos, 0).r * 255.0 + 0.5);
+	return texelFetch(uPalette, ivec2(index, 0), 0).rgb;
+}
+
+void main() {
+	// Indices can't be interpolated, so bilinear filtering is done after the palette lookup
+	vec2 pixel = vTexCoords * vec2(textureSize(uTexture, 0)) - 0.5;
+	vec2 frac = fract(pixel);
+	ivec2 maxPos = ivec2(uFrameSize) - 1;
+	ivec2 pos0 = clamp(ivec2(floor(pixel)), ivec2(0), maxPos);
+	ivec2 pos1 = min(pos0 + 1, maxPos);
+
+	vec3 top = mix(lookup(pos0), lookup(ivec2(pos1.x, pos0.y)), frac.x);
+	vec3 bottom = mix(lookup(ivec2(pos0.x, pos1.y)), lookup(pos1), frac.x);
+	fragColor = vec4(mix(top, bottom, frac.y), 1.0) * vColor;
+}
 )";
 }
\ No newline at end of file
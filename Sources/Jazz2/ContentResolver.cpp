@@ -12,6 +12,7 @@
 #include "../nCine/IO/MemoryFile.h"
 #include "../nCine/Graphics/ITextureLoader.h"
 #include "../nCine/Base/Random.h"
+#include "../nCine/Base/HashFunctions.h"
 
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../nCine/Backends/Android/AndroidApplication.h"
@@ -42,7 +43,15 @@ namespace Jazz2
 		:
 		_isLoading(false),
 		_cachedMetadata(64),
-		_cachedGraphics(128)
+		_cachedGraphics(128),
+		_cachedSounds(192),
+		_cachedSoundHashes(256),
+#if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_IOS)
+		// Long samples are kept compressed on devices with limited memory
+		_compressLongSounds(true)
+#else
+		_compressLongSounds(false)
+#endif
 	{
 		std::memset(_palettes, 0, sizeof(_palettes));
 
@@ -116,6 +125,8 @@ namespace Jazz2
 	{
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
+		_cachedSounds.clear();
+		_cachedSoundHashes.clear();
 
 		for (int i = 0; i < (int)FontType::Count; i++) {
 			_fonts[i] = nullptr;
@@ -165,6 +176,18 @@ namespace Jazz2
 			}
 		}
 
+		// Release sounds that are no longer referenced by any metadata
+		{
+			auto it = _cachedSounds.begin();
+			while (it != _cachedSounds.end()) {
+				if (it->second.use_count() <= 1) {
+					it = _cachedSounds.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
 		_isLoading = false;
 	}
 
@@ -343,7 +366,10 @@ namespace Jazz2
 								continue;
 							}
 						}
-						sound.Buffers.emplace_back(std::make_unique<AudioBuffer>(fullPath));
+						auto buffer = RequestSound(fullPath);
+						if (buffer != nullptr) {
+							sound.Buffers.emplace_back(std::move(buffer));
+						}
 					}
 
 					if (!sound.Buffers.empty()) {
@@ -356,6 +382,53 @@ namespace Jazz2
 		return _cachedMetadata.emplace(path, std::move(metadata)).first->second.get();
 	}
 
+	std::shared_ptr<AudioBuffer> ContentResolver::RequestSound(const StringView& path)
+	{
+		// Content files don't change while the game is running, so the hash of the same path can be reused
+		auto hashIt = _cachedSoundHashes.find(String::nullTerminatedView(path));
+		if (hashIt != _cachedSoundHashes.end()) {
+			auto it = _cachedSounds.find(hashIt->second);
+			if (it != _cachedSounds.end()) {
+				return it->second;
+			}
+		}
+
+		uint64_t hash;
+		int64_t fileSize;
+		{
+			auto s = fs::Open(path, FileAccessMode::Read);
+			fileSize = s->GetSize();
+			if (fileSize <= 0 || fileSize > 64 * 1024 * 1024) {
+				// 64 MB file size limit
+				return nullptr;
+			}
+
+			auto buffer = std::make_unique<unsigned char[]>(fileSize);
+			s->Read(buffer.get(), fileSize);
+			s->Close();
+
+			// The same sample is often referenced by more metadata files (or even under different names)
+			hash = fasthash64(buffer.get(), fileSize, fileSize);
+			_cachedSoundHashes[path] = hash;
+			auto it = _cachedSounds.find(hash);
+			if (it != _cachedSounds.end()) {
+				return it->second;
+			}
+		}
+
+		// Loader detects the format from file extension, so the file is opened again
+		auto audioBuffer = std::make_shared<AudioBuffer>();
+		bool hasLoaded = (_compressLongSounds && fileSize >= CompressedSoundMinSize
+			? audioBuffer->loadFromFileCompressed(path)
+			: audioBuffer->loadFromFile(path));
+		if (!hasLoaded) {
+			LOGE_X("Audio file \"%s\" cannot be loaded", String::nullTerminatedView(path).data());
+			return nullptr;
+		}
+
+		return _cachedSounds.emplace(hash, std::move(audioBuffer)).first->second;
+	}
+
 	GenericGraphicResource* ContentResolver::RequestGraphics(const StringView& path, uint16_t paletteOffset)
 	{
 		// First resources are requested, reset _isLoading flag, because palette should be already applied
@@ -1001,14 +1074,11 @@ namespace Jazz2
 	{
 		_precompiledShaders[(int)PrecompiledShader::Lighting] = std::make_unique<Shader>("Lighting",
 			Shader::LoadMode::String, Shaders::LightingVs, Shaders::LightingFs);
-		_precompiledShaders[(int)PrecompiledShader::BatchedLighting] = std::make_unique<Shader>("BatchedLighting",
-			Shader::LoadMode::String, Shader::Introspection::NoUniformsInBlocks, Shaders::BatchedLightingVs, Shaders::LightingFs);
-		_precompiledShaders[(int)PrecompiledShader::Lighting]->registerBatchedShader(*_precompiledShaders[(int)PrecompiledShader::BatchedLighting]);
-
-		_precompiledShaders[(int)PrecompiledShader::Blur] = std::make_unique<Shader>("Blur",
-			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::BlurFs);
-		_precompiledShaders[(int)PrecompiledShader::Downsample] = std::make_unique<Shader>("Downsample",
-			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::DownsampleFs);
+
+		_precompiledShaders[(int)PrecompiledShader::BlurDownsample] = std::make_unique<Shader>("BlurDownsample",
+			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::BlurDownsampleFs);
+		_precompiledShaders[(int)PrecompiledShader::BlurUpsample] = std::make_unique<Shader>("BlurUpsample",
+			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::BlurUpsampleFs);
 		_precompiledShaders[(int)PrecompiledShader::Combine] = std::make_unique<Shader>("Combine",
 			Shader::LoadMode::String, Shaders::CombineVs, Shaders::CombineFs);
 		_precompiledShaders[(int)PrecompiledShader::CombineWithWater] = std::make_unique<Shader>("CombineWithWater",
@@ -1018,6 +1088,8 @@ namespace Jazz2
 			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::TexturedBackgroundFs);
 		_precompiledShaders[(int)PrecompiledShader::TexturedBackgroundCircle] = std::make_unique<Shader>("TexturedBackground",
 			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::TexturedBackgroundCircleFs);
+		_precompiledShaders[(int)PrecompiledShader::TileLayer] = std::make_unique<Shader>("TileLayer",
+			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::TileLayerFs);
 
 		_precompiledShaders[(int)PrecompiledShader::Colorize] = std::make_unique<Shader>("Colorize",
 			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::ColorizeFs);
@@ -1040,6 +1112,9 @@ namespace Jazz2
 		_precompiledShaders[(int)PrecompiledShader::WhiteMask]->registerBatchedShader(*_precompiledShaders[(int)PrecompiledShader::BatchedWhiteMask]);
 		_precompiledShaders[(int)PrecompiledShader::PartialWhiteMask]->registerBatchedShader(*_precompiledShaders[(int)PrecompiledShader::BatchedWhiteMask]);
 
+		_precompiledShaders[(int)PrecompiledShader::Text] = std::make_unique<Shader>("Text",
+			Shader::LoadMode::String, Shaders::TextVs, Shaders::TextFs);
+
 #if defined(ALLOW_RESCALE_SHADERS)
 		_precompiledShaders[(int)PrecompiledShader::ResizeHQ2x] = std::make_unique<Shader>("ResizeHQ2x",
 			Shader::LoadMode::String, Shaders::ResizeHQ2xVs, Shaders::ResizeHQ2xFs);
@@ -1057,6 +1132,8 @@ namespace Jazz2
 
 		_precompiledShaders[(int)PrecompiledShader::Transition] = std::make_unique<Shader>("Transition",
 			Shader::LoadMode::String, Shaders::TransitionVs, Shaders::TransitionFs);
+		_precompiledShaders[(int)PrecompiledShader::Cinematics] = std::make_unique<Shader>("Cinematics",
+			Shader::LoadMode::String, Shader::DefaultVertex::SPRITE, Shaders::CinematicsFs);
 	}
 
 	std::unique_ptr<Texture> ContentResolver::GetNoiseTexture()
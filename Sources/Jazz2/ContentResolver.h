@@ -94,7 +94,8 @@ namespace Jazz2
 	class SoundResource
 	{
 	public:
-		SmallVector<std::unique_ptr<AudioBuffer>, 1> Buffers;
+		// Buffers are shared by all metadata that reference the same sample
+		SmallVector<std::shared_ptr<AudioBuffer>, 1> Buffers;
 	};
 
 	enum class MetadataFlags {
@@ -181,15 +182,15 @@ namespace Jazz2
 
 	enum class PrecompiledShader {
 		Lighting,
-		BatchedLighting,
 
-		Blur,
-		Downsample,
+		BlurDownsample,
+		BlurUpsample,
 		Combine,
 		CombineWithWater,
 
 		TexturedBackground,
 		TexturedBackgroundCircle,
+		TileLayer,
 
 		Colorize,
 		BatchedColorize,
@@ -198,6 +199,7 @@ namespace Jazz2
 		WhiteMask,
 		PartialWhiteMask,
 		BatchedWhiteMask,
+		Text,
 
 #if defined(ALLOW_RESCALE_SHADERS)
 		ResizeHQ2x,
@@ -208,6 +210,7 @@ namespace Jazz2
 #endif
 		Antialiasing,
 		Transition,
+		Cinematics,
 
 		Count
 	};
@@ -288,16 +291,25 @@ namespace Jazz2
 		ContentResolver& operator=(const ContentResolver&) = delete;
 
 		GenericGraphicResource* RequestGraphicsAura(const StringView& path, uint16_t paletteOffset);
+		std::shared_ptr<AudioBuffer> RequestSound(const StringView& path);
 		static void ReadImageFromFile(std::unique_ptr<IFileStream>& s, uint8_t* data, int width, int height, int channelCount);
 		void RecreateGemPalettes();
 #if defined(NCINE_DEBUG)
 		void MigrateGraphics(const StringView& path);
 #endif
 
+		// Samples larger than this size (in bytes) are kept compressed, if enabled
+		static constexpr int64_t CompressedSoundMinSize = 256 * 1024;
+
 		bool _isLoading;
 		uint32_t _palettes[PaletteCount * ColorsPerPalette];
 		HashMap<String, std::unique_ptr<Metadata>> _cachedMetadata;
 		HashMap<Pair<String, uint16_t>, std::unique_ptr<GenericGraphicResource>> _cachedGraphics;
+		// Audio buffers are addressed by hash of file content, so identical samples are loaded only once
+		HashMap<uint64_t, std::shared_ptr<AudioBuffer>> _cachedSounds;
+		// Content hash of already requested sound files, so cached samples are found without reading the file again
+		HashMap<String, uint64_t> _cachedSoundHashes;
+		bool _compressLongSounds;
 		std::unique_ptr<UI::Font> _fonts[(int)FontType::Count];
 		std::unique_ptr<Shader> _precompiledShaders[(int)PrecompiledShader::Count];
 
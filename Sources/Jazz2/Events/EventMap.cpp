@@ -11,8 +11,11 @@ namespace Jazz2::Events
 		:
 		_levelHandler(levelHandler),
 		_layoutSize(layoutSize),
+		_checkpointGeneration(1),
+		_activeX1(0), _activeY1(0), _activeX2(-1), _activeY2(-1),
 		_checkpointCreated(false)
 	{
+		_eventRows.resize(layoutSize.Y);
 	}
 
 	Vector2f EventMap::GetSpawnPosition(PlayerType type)
@@ -42,14 +45,35 @@ namespace Jazz2::Events
 
 	void EventMap::CreateCheckpointForRollback()
 	{
-		std::memcpy(_eventLayoutForRollback.data(), _eventLayout.data(), _eventLayout.size() * sizeof(EventTile));
+		// Only pages modified since the last checkpoint differ from the stored copy
+		int32_t tileCount = (int32_t)_eventLayout.size();
+		for (int32_t page : _dirtyPages) {
+			int32_t first = page * CheckpointPageSize;
+			int32_t count = std::min(CheckpointPageSize, tileCount - first);
+			std::memcpy(&_eventLayoutForRollback[first], &_eventLayout[first], count * sizeof(EventTile));
+		}
+		_dirtyPages.clear();
+		_checkpointGeneration++;
+
+		auto tiles = _levelHandler->TileMap();
+		if (tiles != nullptr) {
+			tiles->CreateCheckpointForRollback();
+		}
 	}
 
 	void EventMap::RollbackToCheckpoint()
 	{
-		for (int y = 0; y < _layoutSize.Y; y++) {
-			for (int x = 0; x < _layoutSize.X; x++) {
-				int tileID = y * _layoutSize.X + x;
+		// Only pages modified since the last checkpoint have to be restored, spawned actors can modify the layout again,
+		// so the list is moved out and the generation is increased before restoring
+		SmallVector<int32_t, 0> dirtyPages = std::move(_dirtyPages);
+		_dirtyPages.clear();
+		_checkpointGeneration++;
+
+		int32_t tileCount = (int32_t)_eventLayout.size();
+		for (int32_t page : dirtyPages) {
+			int32_t first = page * CheckpointPageSize;
+			int32_t last = std::min(first + CheckpointPageSize, tileCount);
+			for (int32_t tileID = first; tileID < last; tileID++) {
 				EventTile& tile = _eventLayout[tileID];
 				EventTile& tilePrev = _eventLayoutForRollback[tileID];
 
@@ -64,6 +88,8 @@ namespace Jazz2::Events
 					if (tile.Event == EventType::AreaWeather) {
 						_levelHandler->SetWeather((WeatherType)tile.EventParams[0], tile.EventParams[1]);
 					} else if (tile.Event != EventType::Generator) {
+						int x = tileID % _layoutSize.X;
+						int y = tileID / _layoutSize.X;
 						Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | tile.EventFlags;
 						std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::MainPlaneZ);
 						if (actor != nullptr) {
@@ -73,6 +99,18 @@ namespace Jazz2::Events
 				}
 			}
 		}
+
+		auto tiles = _levelHandler->TileMap();
+		if (tiles != nullptr) {
+			tiles->RollbackToCheckpoint();
+		}
+
+		// Active state of the whole layout changed, so the next activation has to scan the whole window again
+		_activeX1 = 0;
+		_activeY1 = 0;
+		_activeX2 = -1;
+		_activeY2 = -1;
+		_pendingCells.clear();
 	}
 
 	void EventMap::StoreTileEvent(int x, int y, EventType eventType, Actors::ActorState eventFlags, uint8_t* tileParams)
@@ -93,7 +131,18 @@ namespace Jazz2::Events
 			std::memcpy(newEvent.EventParams, tileParams, sizeof(newEvent.EventParams));
 		}
 
+		if (eventType != EventType::Empty) {
+			if (previousEvent.Event == EventType::Empty) {
+				AddEventCell(x, y);
+			}
+			if (!newEvent.IsEventActive && IsInActiveWindow(x, y)) {
+				// Window was already scanned, activate the new event in the next call
+				_pendingCells.push_back(x + y * _layoutSize.X);
+			}
+		}
+
 		previousEvent = newEvent;
+		MarkDirty(x + y * _layoutSize.X);
 	}
 
 	void EventMap::PreloadEventsAsync()
@@ -104,10 +153,13 @@ namespace Jazz2::Events
 		//ContentResolver::Current().SuspendAsync();
 
 		// Preload all events
-		for (auto& tile : _eventLayout) {
-			// TODO: Exclude also some modifiers here ?
-			if (tile.Event != EventType::Empty && tile.Event != EventType::Generator && tile.Event != EventType::AreaWeather) {
-				eventSpawner->PreloadEvent(tile.Event, tile.EventParams);
+		for (int y = 0; y < _layoutSize.Y; y++) {
+			for (int32_t x : _eventRows[y]) {
+				auto& tile = _eventLayout[x + y * _layoutSize.X];
+				// TODO: Exclude also some modifiers here ?
+				if (tile.Event != EventType::Empty && tile.Event != EventType::Generator && tile.Event != EventType::AreaWeather) {
+					eventSpawner->PreloadEvent(tile.Event, tile.EventParams);
+				}
 			}
 		}
 
@@ -162,40 +214,111 @@ namespace Jazz2::Events
 		int y1 = std::max(0, ty1);
 		int y2 = std::min(_layoutSize.Y - 1, ty2);
 
-		for (int x = x1; x <= x2; x++) {
-			for (int y = y1; y <= y2; y++) {
-				auto& tile = _eventLayout[x + y * _layoutSize.X];
-				if (!tile.IsEventActive && tile.Event != EventType::Empty) {
-					tile.IsEventActive = true;
+		// Events inside the previous window are already active, so only strips that entered the window have to be scanned
+		if (_activeX1 > _activeX2 || _activeY1 > _activeY2 || x1 > _activeX2 || x2 < _activeX1 || y1 > _activeY2 || y2 < _activeY1) {
+			ActivateEventsInRange(x1, y1, x2, y2, allowAsync);
+		} else {
+			if (y1 < _activeY1) {
+				ActivateEventsInRange(x1, y1, x2, _activeY1 - 1, allowAsync);
+			}
+			if (y2 > _activeY2) {
+				ActivateEventsInRange(x1, _activeY2 + 1, x2, y2, allowAsync);
+			}
 
-					if (tile.Event == EventType::AreaWeather) {
-						_levelHandler->SetWeather((WeatherType)tile.EventParams[0], tile.EventParams[1]);
-					} else if (tile.Event != EventType::Generator) {
-						Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | tile.EventFlags;
-						if (allowAsync) {
-							flags |= Actors::ActorState::Async;
-						}
+			int ry1 = std::max(y1, _activeY1);
+			int ry2 = std::min(y2, _activeY2);
+			if (x1 < _activeX1) {
+				ActivateEventsInRange(x1, ry1, _activeX1 - 1, ry2, allowAsync);
+			}
+			if (x2 > _activeX2) {
+				ActivateEventsInRange(_activeX2 + 1, ry1, x2, ry2, allowAsync);
+			}
+		}
 
-						std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
-						if (actor != nullptr) {
-							_levelHandler->AddActor(actor);
-						}
-					}
+		_activeX1 = x1;
+		_activeY1 = y1;
+		_activeX2 = x2;
+		_activeY2 = y2;
+
+		// Events that were deactivated or added inside the window since the last call
+		if (!_pendingCells.empty()) {
+			for (int32_t tileID : _pendingCells) {
+				int x = tileID % _layoutSize.X;
+				int y = tileID / _layoutSize.X;
+				if (IsInActiveWindow(x, y)) {
+					ActivateEvent(x, y, allowAsync);
 				}
 			}
+			_pendingCells.clear();
 		}
 
 		if (!_checkpointCreated) {
 			// Create checkpoint after first call to ActivateEvents() to avoid duplication of objects that are spawned near player spawn
-			std::memcpy(_eventLayoutForRollback.data(), _eventLayout.data(), _eventLayout.size() * sizeof(EventTile));
+			CreateCheckpointForRollback();
 			_checkpointCreated = true;
 		}
 	}
 
+	void EventMap::ActivateEventsInRange(int x1, int y1, int x2, int y2, bool allowAsync)
+	{
+		for (int y = y1; y <= y2; y++) {
+			auto& row = _eventRows[y];
+			auto it = std::lower_bound(row.begin(), row.end(), x1);
+			// Spawning can add new event cells, so indices are used instead of iterators
+			for (int i = (int)(it - row.begin()); i < (int)row.size() && row[i] <= x2; i++) {
+				ActivateEvent(row[i], y, allowAsync);
+			}
+		}
+	}
+
+	void EventMap::ActivateEvent(int x, int y, bool allowAsync)
+	{
+		auto& tile = _eventLayout[x + y * _layoutSize.X];
+		if (tile.IsEventActive || tile.Event == EventType::Empty) {
+			return;
+		}
+
+		tile.IsEventActive = true;
+		MarkDirty(x + y * _layoutSize.X);
+
+		if (tile.Event == EventType::AreaWeather) {
+			_levelHandler->SetWeather((WeatherType)tile.EventParams[0], tile.EventParams[1]);
+		} else if (tile.Event != EventType::Generator) {
+			Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | tile.EventFlags;
+			if (allowAsync) {
+				flags |= Actors::ActorState::Async;
+			}
+
+			std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
+			if (actor != nullptr) {
+				_levelHandler->AddActor(actor);
+			}
+		}
+	}
+
+	void EventMap::AddEventCell(int x, int y)
+	{
+		auto& row = _eventRows[y];
+		auto it = std::lower_bound(row.begin(), row.end(), x);
+		if (it == row.end() || *it != x) {
+			row.insert(it, x);
+		}
+	}
+
+	bool EventMap::IsInActiveWindow(int x, int y) const
+	{
+		return (x >= _activeX1 && x <= _activeX2 && y >= _activeY1 && y <= _activeY2);
+	}
+
 	void EventMap::Deactivate(int x, int y)
 	{
 		if (HasEventByPosition(x, y)) {
 			_eventLayout[x + y * _layoutSize.X].IsEventActive = false;
+			MarkDirty(x + y * _layoutSize.X);
+			if (IsInActiveWindow(x, y)) {
+				// Window was already scanned, activate the event again in the next call
+				_pendingCells.push_back(x + y * _layoutSize.X);
+			}
 		}
 	}
 
@@ -284,6 +407,7 @@ namespace Jazz2::Events
 	{
 		_eventLayout.resize(_layoutSize.X * _layoutSize.Y);
 		_eventLayoutForRollback.resize(_layoutSize.X * _layoutSize.Y);
+		_pageGenerations.resize((_layoutSize.X * _layoutSize.Y + CheckpointPageSize - 1) / CheckpointPageSize);
 
 		uint8_t difficultyBit;
 		switch (difficulty) {
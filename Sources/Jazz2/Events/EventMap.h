@@ -36,6 +36,8 @@ namespace Jazz2::Events
 		void AddSpawnPosition(uint8_t typeMask, int x, int y);
 
 	private:
+		static constexpr int32_t CheckpointPageSize = 256;
+
 		struct EventTile {
 			EventType Event;
 			Actors::ActorState EventFlags;
@@ -68,9 +70,32 @@ namespace Jazz2::Events
 		Vector2i _layoutSize;
 		SmallVector<EventTile, 0> _eventLayout;
 		SmallVector<EventTile, 0> _eventLayoutForRollback;
+		// Pages of the layout modified since the last checkpoint, only these are copied or restored
+		SmallVector<uint32_t, 0> _pageGenerations;
+		SmallVector<int32_t, 0> _dirtyPages;
+		uint32_t _checkpointGeneration;
+		// Sorted X coordinates of all cells that ever contained an event, for each row
+		SmallVector<SmallVector<int32_t, 0>, 0> _eventRows;
+		// Currently activated window (inclusive), events inside are already active
+		int _activeX1, _activeY1, _activeX2, _activeY2;
+		SmallVector<int32_t, 0> _pendingCells;
 		SmallVector<GeneratorInfo, 0> _generators;
 		SmallVector<SpawnPoint, 0> _spawnPoints;
 		SmallVector<WarpTarget, 0> _warpTargets;
 		bool _checkpointCreated;
+
+		void ActivateEventsInRange(int x1, int y1, int x2, int y2, bool allowAsync);
+		void ActivateEvent(int x, int y, bool allowAsync);
+		void AddEventCell(int x, int y);
+		bool IsInActiveWindow(int x, int y) const;
+
+		void MarkDirty(int32_t tileID)
+		{
+			int32_t page = tileID / CheckpointPageSize;
+			if (_pageGenerations[page] != _checkpointGeneration) {
+				_pageGenerations[page] = _checkpointGeneration;
+				_dirtyPages.push_back(page);
+			}
+		}
 	};
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#include "EventSpawner.h"
+#include "../Actors/ActorPool.h"
 
 #include "../Actors/Collectibles/AmmoCollectible.h"
 #include "../Actors/Collectibles/CarrotCollectible.h"
@@ -222,7 +223,7 @@ namespace Jazz2::Events
 	void EventSpawner::RegisterSpawnable(EventType type)
 	{
 		_spawnableEvents[type] = { [](const ActorActivationDetails& details) -> std::shared_ptr<ActorBase> {
-			std::shared_ptr<ActorBase> actor = std::make_shared<T>();
+			std::shared_ptr<ActorBase> actor = CreatePooledActor<T>();
 			actor->OnActivated(details);
 			return actor;
 		}, T::Preload };
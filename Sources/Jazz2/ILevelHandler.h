@@ -54,8 +54,11 @@ namespace Jazz2
 
 		virtual void AddActor(std::shared_ptr<Actors::ActorBase> actor) = 0;
 
+		/// Plays a sound immediately, the returned player is owned by the caller and it's never merged with other sounds
 		virtual std::shared_ptr<AudioBufferPlayer> PlaySfx(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain = 1.0f, float pitch = 1.0f) = 0;
-		virtual std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) = 0;
+		/// Requests a fire-and-forget sound, the same sounds requested in one frame can be merged together
+		virtual void RequestSfx(AudioBuffer* buffer, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) = 0;
+		virtual void PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) = 0;
 		virtual void WarpCameraToTarget(const std::shared_ptr<Actors::ActorBase>& actor) = 0;
 		virtual bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, TileCollisionParams& params, Actors::ActorBase** collider) = 0;
 
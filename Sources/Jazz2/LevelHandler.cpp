@@ -19,7 +19,10 @@
 #include "../nCine/Graphics/RenderQueue.h"
 #include "../nCine/Audio/AudioReaderMpt.h"
 #include "../nCine/Base/Random.h"
+#include "../nCine/Base/TimeStamp.h"
+#include "../nCine/tracy.h"
 
+#include "Actors/ActorPool.h"
 #include "Actors/Player.h"
 #include "Actors/SolidObjectBase.h"
 #include "Actors/Enemies/Bosses/BossBase.h"
@@ -42,16 +45,21 @@ namespace Jazz2
 		_cheatsUsed(levelInit.CheatsUsed),
 		_nextLevelType(ExitType::None),
 		_nextLevelTime(0.0f),
+		_eventActorsDirty(false),
+		_updateFrameCounter(0),
+		_actorsPerUpdateTier(),
 		_elapsedFrames(0.0f),
 		_shakeDuration(0.0f),
 		_waterLevel(FLT_MAX),
 		_ambientLightTarget(1.0f),
 		_weatherType(WeatherType::None),
-		_downsamplePass(this),
-		_blurPass1(this),
-		_blurPass2(this),
-		_blurPass3(this),
-		_blurPass4(this),
+		_downsamplePass1(this),
+		_downsamplePass2(this),
+		_downsamplePass3(this),
+		_upsamplePass1(this),
+		_upsamplePass2(this),
+		_blurHalfTarget(nullptr),
+		_blurQuarterTarget(nullptr),
 		_pressedKeys((uint32_t)KeySym::COUNT),
 		_pressedActions(0),
 		_overrideActions(0),
@@ -218,6 +226,7 @@ namespace Jazz2
 	{
 		float timeMult = theApplication().timeMult();
 
+		Actors::ActorPool::ResetFrameStatistics();
 		UpdatePressedActions();
 
 		if (PlayerActionHit(0, PlayerActions::Menu) && _pauseMenu == nullptr && _nextLevelType == ExitType::None) {
@@ -238,14 +247,6 @@ namespace Jazz2
 			}
 		}
 
-		for (int i = (int)_playingSounds.size() - 1; i >= 0; i--) {
-			if (_playingSounds[i]->state() == IAudioPlayer::PlayerState::Stopped) {
-				_playingSounds.erase(&_playingSounds[i]);
-			} else {
-				break;
-			}
-		}
-
 		if (_pauseMenu == nullptr) {
 			if (_nextLevelType != ExitType::None) {
 				_nextLevelTime -= timeMult;
@@ -327,21 +328,11 @@ namespace Jazz2
 					int tx2d = tx2 + 4;
 					int ty2d = ty2 + 4;
 
-					for (auto& actor : _actors) {
-						if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
-							Vector2i originTile = actor->_originTile;
-							if (originTile.X < tx1d || originTile.Y < ty1d || originTile.X > tx2d || originTile.Y > ty2d) {
-								if (actor->OnTileDeactivated()) {
-									if ((actor->_state & Actors::ActorState::IsFromGenerator) == Actors::ActorState::IsFromGenerator) {
-										_eventMap->ResetGenerator(originTile.X, originTile.Y);
-									}
-
-									_eventMap->Deactivate(originTile.X, originTile.Y);
-
-									actor->_state |= Actors::ActorState::IsDestroyed;
-								}
-							}
-						}
+					// Origin tiles don't change, so actors have to be checked only if the range moved or new actors were added
+					Recti deactivationRange = Recti::FromMinMax(tx1d, ty1d, tx2d, ty2d);
+					if (_eventActorsDirty || !(_eventActorsRange == deactivationRange)) {
+						_eventActorsRange = deactivationRange;
+						DeactivateEventActors(tx1d, ty1d, tx2d, ty2d);
 					}
 
 					_eventMap->ActivateEvents(tx1, ty1, tx2, ty2, true);
@@ -350,6 +341,8 @@ namespace Jazz2
 				_eventMap->ProcessGenerators(timeMult);
 			}
 
+			ScheduleActorUpdates();
+
 			// Weather
 			if (_weatherType != WeatherType::None) {
 				int weatherIntensity = std::max((int)(_weatherIntensity * timeMult), 1);
@@ -485,6 +478,9 @@ namespace Jazz2
 			_elapsedFrames += timeMult;
 		}
 
+		// All sounds of this frame were requested and the camera is already updated
+		FlushSfxRequests();
+
 		_lightingView->setClearColor(_ambientColor.W, 0.0f, 0.0f, 1.0f);
 	}
 
@@ -529,8 +525,11 @@ namespace Jazz2
 		if (_lightingRenderer == nullptr) {
 			auto& resolver = ContentResolver::Current();
 			_lightingShader = resolver.GetShader(PrecompiledShader::Lighting);
-			_blurShader = resolver.GetShader(PrecompiledShader::Blur);
-			_downsampleShader = resolver.GetShader(PrecompiledShader::Downsample);
+			_lightingShader->setAttribute("aPosition", sizeof(LightingRenderer::LightVertex), offsetof(LightingRenderer::LightVertex, X));
+			_lightingShader->setAttribute("aTexCoords", sizeof(LightingRenderer::LightVertex), offsetof(LightingRenderer::LightVertex, CornerX));
+			_lightingShader->setAttribute("aLight", sizeof(LightingRenderer::LightVertex), offsetof(LightingRenderer::LightVertex, Intensity));
+			_blurDownsampleShader = resolver.GetShader(PrecompiledShader::BlurDownsample);
+			_blurUpsampleShader = resolver.GetShader(PrecompiledShader::BlurUpsample);
 			_combineShader = resolver.GetShader(PrecompiledShader::Combine);
 			_combineWithWaterShader = resolver.GetShader(PrecompiledShader::CombineWithWater);
 
@@ -551,20 +550,49 @@ namespace Jazz2
 
 		_lightingBuffer->setMagFiltering(SamplerFilter::Nearest);
 
-		_downsamplePass.Initialize(_viewTexture.get(), w / 2, h / 2, Vector2f::Zero);
-		_blurPass1.Initialize(_downsamplePass.GetTarget(), w / 2, h / 2, Vector2f(1.0f, 0.0f));
-		_blurPass2.Initialize(_blurPass1.GetTarget(), w / 2, h / 2, Vector2f(0.0f, 1.0f));
-		_blurPass3.Initialize(_blurPass2.GetTarget(), w / 4, h / 4, Vector2f(1.0f, 0.0f));
-		_blurPass4.Initialize(_blurPass3.GetTarget(), w / 4, h / 4, Vector2f(0.0f, 1.0f));
+		// Dual-filter blur pyramid, every pass reads the previous target with bilinear filtering
+		BlurRenderPass* blurPasses[5];
+		int blurPassCount = 0;
+		switch (PreferencesCache::ActiveBlurQuality) {
+			case BlurQuality::High: {
+				_downsamplePass1.Initialize("BlurDownsample1", _viewTexture.get(), w / 2, h / 2, false);
+				_downsamplePass2.Initialize("BlurDownsample2", _downsamplePass1.GetTarget(), w / 4, h / 4, false);
+				_downsamplePass3.Initialize("BlurDownsample3", _downsamplePass2.GetTarget(), std::max(w / 8, 1), std::max(h / 8, 1), false);
+				_upsamplePass1.Initialize("BlurUpsample1", _downsamplePass3.GetTarget(), w / 4, h / 4, true);
+				_upsamplePass2.Initialize("BlurUpsample2", _upsamplePass1.GetTarget(), w / 2, h / 2, true);
+				blurPasses[blurPassCount++] = &_downsamplePass1;
+				blurPasses[blurPassCount++] = &_downsamplePass2;
+				blurPasses[blurPassCount++] = &_downsamplePass3;
+				blurPasses[blurPassCount++] = &_upsamplePass1;
+				blurPasses[blurPassCount++] = &_upsamplePass2;
+				_blurHalfTarget = _upsamplePass2.GetTarget();
+				_blurQuarterTarget = _upsamplePass1.GetTarget();
+				break;
+			}
+			case BlurQuality::Low: {
+				_downsamplePass1.Initialize("BlurDownsample1", _viewTexture.get(), w / 2, h / 2, false);
+				_downsamplePass2.Initialize("BlurDownsample2", _downsamplePass1.GetTarget(), w / 4, h / 4, false);
+				blurPasses[blurPassCount++] = &_downsamplePass1;
+				blurPasses[blurPassCount++] = &_downsamplePass2;
+				_blurHalfTarget = _downsamplePass1.GetTarget();
+				_blurQuarterTarget = _downsamplePass2.GetTarget();
+				break;
+			}
+			default: {
+				// No additional passes, the combine pass samples the unblurred view instead
+				_blurHalfTarget = _viewTexture.get();
+				_blurQuarterTarget = _viewTexture.get();
+				break;
+			}
+		}
+
 		_upscalePass.Initialize(w, h, width, height);
 
 		// Viewports must be registered in reverse order
 		_upscalePass.Register();
-		_blurPass4.Register();
-		_blurPass3.Register();
-		_blurPass2.Register();
-		_blurPass1.Register();
-		_downsamplePass.Register();
+		for (int i = blurPassCount - 1; i >= 0; i--) {
+			blurPasses[i]->Register();
+		}
 
 		Viewport::chain().push_back(_lightingView.get());
 
@@ -614,47 +642,50 @@ namespace Jazz2
 			actor->CollisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get());
 		}
 
+		if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
+			_eventActors.emplace_back(actor);
+			_eventActorsDirty = true;
+		}
+
 		_actors.emplace_back(actor);
 	}
 
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
 	{
-		auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(buffer));
-		player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
-		player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
-		player->setSourceRelative(sourceRelative);
-
-		if (pos.Y >= _waterLevel) {
-			player->setLowPass(0.05f);
-			player->setPitch(pitch * 0.7f);
+		// The caller can control the player, so it's started immediately and never merged with other sounds
+		auto player = RentSfxPlayer(buffer, pos, sourceRelative, gain, pitch);
+		if (!sourceRelative && IsSfxCulled(Vector2f(pos.X, pos.Y))) {
+			// Sounds that are too far from the camera aren't played at all, unless they are made looping later in this frame
+			_culledSfxPlayers.push_back(player);
 		} else {
-			player->setPitch(pitch);
+			player->play();
 		}
 
-		player->play();
+		_playingSounds.push_back(player);
 		return player;
 	}
 
-	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain, float pitch)
+	void LevelHandler::RequestSfx(AudioBuffer* buffer, const Vector3f& pos, float gain, float pitch)
+	{
+		// Merge the same sounds requested at nearly the same position in one frame (e.g., collected gems or chained explosions)
+		Vector2f pos2(pos.X, pos.Y);
+		for (auto& request : _sfxRequests) {
+			if (request.Buffer == buffer && std::abs(request.Pitch - pitch) < 0.05f &&
+				(request.Pos - pos2).SqrLength() < SfxMergeDistance * SfxMergeDistance) {
+				request.Gain = std::min(std::sqrt(request.Gain * request.Gain + gain * gain), std::max(request.Gain, gain) * SfxMaxMergedGain);
+				return;
+			}
+		}
+
+		_sfxRequests.push_back({ buffer, pos2, gain, pitch });
+	}
+
+	void LevelHandler::PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain, float pitch)
 	{
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _commonResources->Sounds.end()) {
 			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
-			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
-			player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
-			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
-
-			if (pos.Y >= _waterLevel) {
-				player->setLowPass(/*0.2f*/0.05f);
-				player->setPitch(pitch * 0.7f);
-			} else {
-				player->setPitch(pitch);
-			}
-
-			player->play();
-			return player;
-		} else {
-			return nullptr;
+			RequestSfx(it->second.Buffers[idx].get(), pos, gain, pitch);
 		}
 	}
 
@@ -981,22 +1012,9 @@ namespace Jazz2
 				tx2 += ActivateTileRange;
 				ty2 += ActivateTileRange;
 
-				for (auto& actor : _actors) {
-					if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
-						Vector2i originTile = actor->_originTile;
-						if (originTile.X < tx1 || originTile.Y < ty1 || originTile.X > tx2 || originTile.Y > ty2) {
-							if (actor->OnTileDeactivated()) {
-								if ((actor->_state & Actors::ActorState::IsFromGenerator) == Actors::ActorState::IsFromGenerator) {
-									_eventMap->ResetGenerator(originTile.X, originTile.Y);
-								}
-
-								_eventMap->Deactivate(originTile.X, originTile.Y);
-
-								actor->_state |= Actors::ActorState::IsDestroyed;
-							}
-						}
-					}
-				}
+				DeactivateEventActors(tx1, ty1, tx2, ty2);
+				// Inner range differs from the regular one, so force full check in the next frame
+				_eventActorsDirty = true;
 			}
 
 			_eventMap->RollbackToCheckpoint();
@@ -1016,6 +1034,7 @@ namespace Jazz2
 			_sugarRushMusic->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
 			_sugarRushMusic->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
 			_sugarRushMusic->setSourceRelative(true);
+			_sugarRushMusic->setPriority(IAudioPlayer::Priority::Critical);
 			_sugarRushMusic->play();
 
 			if (_music != nullptr) {
@@ -1158,6 +1177,84 @@ namespace Jazz2
 		return (_playerFrozenEnabled ? _playerFrozenMovement.Y : _playerRequiredMovement.Y);
 	}
 
+	void LevelHandler::DeactivateEventActors(int tx1, int ty1, int tx2, int ty2)
+	{
+		_eventActorsDirty = false;
+
+		// Actors can be added while iterating, so indices are used instead of iterators
+		for (int i = (int)_eventActors.size() - 1; i >= 0; i--) {
+			std::shared_ptr<Actors::ActorBase> actor = _eventActors[i].lock();
+			if (actor == nullptr || (actor->_state & Actors::ActorState::IsDestroyed) == Actors::ActorState::IsDestroyed ||
+				(actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) == Actors::ActorState::None) {
+				// Actor was destroyed or it's no longer bound to its origin tile (e.g., it was taken out of a container)
+				_eventActors[i] = std::move(_eventActors.back());
+				_eventActors.pop_back();
+				continue;
+			}
+
+			Vector2i originTile = actor->_originTile;
+			if (originTile.X < tx1 || originTile.Y < ty1 || originTile.X > tx2 || originTile.Y > ty2) {
+				if (actor->OnTileDeactivated()) {
+					if ((actor->_state & Actors::ActorState::IsFromGenerator) == Actors::ActorState::IsFromGenerator) {
+						_eventMap->ResetGenerator(originTile.X, originTile.Y);
+					}
+
+					_eventMap->Deactivate(originTile.X, originTile.Y);
+
+					actor->_state |= Actors::ActorState::IsDestroyed;
+				} else {
+					// Actor refused to be deactivated, so it has to be checked again in the next frame
+					_eventActorsDirty = true;
+				}
+			}
+		}
+	}
+
+	void LevelHandler::ScheduleActorUpdates()
+	{
+		constexpr float FullUpdateMargin = 128.0f;
+		constexpr float ReducedUpdateMargin = 384.0f;
+
+		Vector2i viewSize = _viewTexture->size();
+		float fullX = viewSize.X * 0.5f + FullUpdateMargin;
+		float fullY = viewSize.Y * 0.5f + FullUpdateMargin;
+		float reducedX = viewSize.X * 0.5f + ReducedUpdateMargin;
+		float reducedY = viewSize.Y * 0.5f + ReducedUpdateMargin;
+
+		_updateFrameCounter++;
+		std::memset(_actorsPerUpdateTier, 0, sizeof(_actorsPerUpdateTier));
+
+		for (auto& actor : _actors) {
+			Actors::ActorUpdateTier tier;
+			float dx = std::abs(actor->_pos.X - _cameraPos.X);
+			float dy = std::abs(actor->_pos.Y - _cameraPos.Y);
+			if ((dx <= fullX && dy <= fullY) ||
+				(actor->_state & (Actors::ActorState::AlwaysFullUpdate | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
+				tier = Actors::ActorUpdateTier::Full;
+			} else if (dx <= reducedX && dy <= reducedY) {
+				tier = Actors::ActorUpdateTier::Reduced;
+			} else {
+				tier = Actors::ActorUpdateTier::Dormant;
+			}
+
+			actor->_updateTier = tier;
+			if (tier == Actors::ActorUpdateTier::Full) {
+				actor->_updateScheduled = true;
+			} else {
+				// Spread updates of actors across frames, so all of them are not updated in the same frame
+				uint32_t interval = (tier == Actors::ActorUpdateTier::Reduced ? 2 : 4);
+				uint32_t slot = (uint32_t)(reinterpret_cast<uintptr_t>(actor.get()) >> 6);
+				actor->_updateScheduled = ((_updateFrameCounter + slot) % interval == 0);
+			}
+
+			_actorsPerUpdateTier[(int)tier]++;
+		}
+
+		TracyPlot("Actors (Full Update)", static_cast<int64_t>(_actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Full]));
+		TracyPlot("Actors (Reduced Update)", static_cast<int64_t>(_actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Reduced]));
+		TracyPlot("Actors (Dormant)", static_cast<int64_t>(_actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Dormant]));
+	}
+
 	void LevelHandler::ResolveCollisions(float timeMult)
 	{
 		auto it = _actors.begin();
@@ -1447,6 +1544,67 @@ namespace Jazz2
 		_pressedActions |= _overrideActions;
 	}
 
+	void LevelHandler::FlushSfxRequests()
+	{
+		// Fire-and-forget sounds are started only once per frame, after all requests were merged
+		for (auto& request : _sfxRequests) {
+			if (!IsSfxCulled(request.Pos)) {
+				auto player = RentSfxPlayer(request.Buffer, Vector3f(request.Pos.X, request.Pos.Y, 0.0f), false, request.Gain, request.Pitch);
+				player->play();
+				_playingSounds.push_back(std::move(player));
+			}
+		}
+		_sfxRequests.clear();
+
+		// Culled sounds that were made looping by the caller are played anyway, because the listener may come closer
+		for (auto& player : _culledSfxPlayers) {
+			if (player->isLooping() && player->state() != IAudioPlayer::PlayerState::Playing) {
+				player->play();
+			}
+		}
+		_culledSfxPlayers.clear();
+
+		// Remove all finished sounds, players not referenced from anywhere else can be reused
+		for (int i = (int)_playingSounds.size() - 1; i >= 0; i--) {
+			auto& player = _playingSounds[i];
+			IAudioPlayer::PlayerState state = player->state();
+			if (state == IAudioPlayer::PlayerState::Stopped || state == IAudioPlayer::PlayerState::Initial) {
+				if (player.use_count() == 1 && _sfxPlayerPool.size() < SfxPlayerPoolSize) {
+					_sfxPlayerPool.push_back(std::move(player));
+				}
+				_playingSounds.erase(&_playingSounds[i]);
+			}
+		}
+	}
+
+	std::shared_ptr<AudioBufferPlayer> LevelHandler::RentSfxPlayer(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
+	{
+		std::shared_ptr<AudioBufferPlayer> player;
+		if (_sfxPlayerPool.empty()) {
+			player = std::make_shared<AudioBufferPlayer>(buffer);
+		} else {
+			player = _sfxPlayerPool.pop_back_val();
+			player->setAudioBuffer(buffer);
+			player->setLooping(false);
+		}
+
+		bool isUnderwater = (pos.Y >= _waterLevel);
+		player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
+		player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
+		player->setPitch(isUnderwater ? pitch * 0.7f : pitch);
+		player->setLowPass(isUnderwater ? 0.05f : 1.0f);
+		player->setSourceRelative(sourceRelative);
+		// Only player sounds are relative to the listener, they shouldn't be replaced by other sounds
+		player->setPriority(sourceRelative ? IAudioPlayer::Priority::High : IAudioPlayer::Priority::Normal);
+		return player;
+	}
+
+	bool LevelHandler::IsSfxCulled(const Vector2f& pos) const
+	{
+		constexpr float MaxDistance = IAudioDevice::MaxDistance / IAudioDevice::LengthToPhysical;
+		return ((Vector3f(pos.X, pos.Y, 100.0f) - Vector3f(_cameraPos.X, _cameraPos.Y, 0.0f)).SqrLength() > MaxDistance * MaxDistance);
+	}
+
 	void LevelHandler::PauseGame()
 	{
 		// Show in-game pause menu
@@ -1496,25 +1654,78 @@ namespace Jazz2
 
 	bool LevelHandler::LightingRenderer::OnDraw(RenderQueue& renderQueue)
 	{
+		TimeStamp start = TimeStamp::now();
+
 		_renderCommandsCount = 0;
 		_emittedLightsCache.clear();
 
-		// Collect all active light emitters
+		// Lighting view uses the same camera and size as the main view, lights that don't reach it are culled
+		Vector2i viewSize = _owner->_view->size();
+		float halfViewX = viewSize.X * 0.5f;
+		float halfViewY = viewSize.Y * 0.5f;
+		Vector2f cameraPos = _owner->_cameraPos;
+
+		// Collect light emitters only from actors that are close enough to the view to light it up
+		float actorCullX = halfViewX + _maxLightReach;
+		float actorCullY = halfViewY + _maxLightReach;
 		for (auto& actor : _owner->_actors) {
+			if (std::abs(actor->_pos.X - cameraPos.X) >= actorCullX ||
+				std::abs(actor->_pos.Y - cameraPos.Y) >= actorCullY) {
+				continue;
+			}
+
+			std::size_t firstLight = _emittedLightsCache.size();
 			actor->OnEmitLights(_emittedLightsCache);
+
+			// Radius of some lights comes from level events, so the margin grows to the largest reach seen so far
+			for (std::size_t i = firstLight; i < _emittedLightsCache.size(); i++) {
+				auto& light = _emittedLightsCache[i];
+				float reach = std::max(std::abs(light.Pos.X - actor->_pos.X), std::abs(light.Pos.Y - actor->_pos.Y)) + light.RadiusFar;
+				if (_maxLightReach < reach) {
+					_maxLightReach = reach;
+				}
+			}
 		}
 
+		static constexpr float Corners[6][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { -1.0f, 1.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f } };
+
+		_vertices.resize_for_overwrite(_emittedLightsCache.size() * 6);
+		_visibleLightsCount = 0;
 		for (auto& light : _emittedLightsCache) {
-			auto command = RentRenderCommand();
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(light.Pos.X, light.Pos.Y, light.RadiusNear / light.RadiusFar, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(light.RadiusFar * 2.0f, light.RadiusFar * 2.0f);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(light.Intensity, light.Brightness, 0.0f, 0.0f);
-			command->setTransformation(Matrix4x4f::Translation(light.Pos.X, light.Pos.Y, 0));
+			if (light.RadiusFar <= 0.0f ||
+				std::abs(light.Pos.X - cameraPos.X) - light.RadiusFar >= halfViewX ||
+				std::abs(light.Pos.Y - cameraPos.Y) - light.RadiusFar >= halfViewY) {
+				continue;
+			}
 
+			LightVertex* vertices = &_vertices[_visibleLightsCount * 6];
+			float radiusNear = light.RadiusNear / light.RadiusFar;
+			for (int i = 0; i < 6; i++) {
+				vertices[i].X = light.Pos.X + Corners[i][0] * light.RadiusFar;
+				vertices[i].Y = light.Pos.Y + Corners[i][1] * light.RadiusFar;
+				vertices[i].CornerX = Corners[i][0];
+				vertices[i].CornerY = Corners[i][1];
+				vertices[i].Intensity = light.Intensity;
+				vertices[i].Brightness = light.Brightness;
+				vertices[i].RadiusNear = radiusNear;
+				vertices[i].RadiusFar = light.RadiusFar;
+			}
+			_visibleLightsCount++;
+		}
+
+		// All visible lights are drawn with a single command, unless they don't fit into one streaming VBO
+		int maxLightsPerCommand = (int)(theApplication().appConfiguration().vboSize / (6 * sizeof(LightVertex)));
+		for (int first = 0; first < _visibleLightsCount; first += maxLightsPerCommand) {
+			int count = std::min(maxLightsPerCommand, _visibleLightsCount - first);
+			auto command = RentRenderCommand();
+			command->geometry().setDrawParameters(GL_TRIANGLES, 0, count * 6);
+			command->geometry().setHostVertexPointer(&_vertices[first * 6].X);
 			renderQueue.addCommand(command);
 		}
 
+		_drawTime = start.millisecondsSince();
+		TracyPlot("Lights", static_cast<int64_t>(_visibleLightsCount));
+
 		return true;
 	}
 
@@ -1530,7 +1741,8 @@ namespace Jazz2
 			command->material().setBlendingEnabled(true);
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
 			command->material().reserveUniformsDataMemory();
-			command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+			command->geometry().setNumElementsPerVertex(sizeof(LightVertex) / sizeof(float));
+			_renderCommandsCount++;
 
 			GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
 			if (textureUniform && textureUniform->intValue(0) != 0) {
@@ -1540,11 +1752,10 @@ namespace Jazz2
 		}
 	}
 
-	void LevelHandler::BlurRenderPass::Initialize(Texture* source, int width, int height, const Vector2f& direction)
+	void LevelHandler::BlurRenderPass::Initialize(const char* name, Texture* source, int width, int height, bool upsample)
 	{
 		_source = source;
-		_downsampleOnly = (direction.X <= std::numeric_limits<float>::epsilon() && direction.Y <= std::numeric_limits<float>::epsilon());
-		_direction = direction;
+		_upsample = upsample;
 
 		bool notInitialized = (_view == nullptr);
 
@@ -1556,7 +1767,7 @@ namespace Jazz2
 
 		if (notInitialized) {
 			_target = std::make_unique<Texture>(nullptr, Texture::Format::RGB8, width, height);
-			_view = std::make_unique<Viewport>(_target.get(), Viewport::DepthStencilFormat::None);
+			_view = std::make_unique<Viewport>(name, _target.get(), Viewport::DepthStencilFormat::None);
 			_view->setRootNode(this);
 			_view->setCamera(_camera.get());
 			//_view->setClearMode(Viewport::ClearMode::Never);
@@ -1568,7 +1779,7 @@ namespace Jazz2
 		_target->setMagFiltering(SamplerFilter::Linear);
 
 		// Prepare render command
-		_renderCommand.material().setShader(_downsampleOnly ? _owner->_downsampleShader : _owner->_blurShader);
+		_renderCommand.material().setShader(_upsample ? _owner->_blurUpsampleShader : _owner->_blurDownsampleShader);
 		//_renderCommand.material().setBlendingEnabled(true);
 		_renderCommand.material().reserveUniformsDataMemory();
 		_renderCommand.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
@@ -1587,16 +1798,14 @@ namespace Jazz2
 	bool LevelHandler::BlurRenderPass::OnDraw(RenderQueue& renderQueue)
 	{
 		auto size = _target->size();
+		auto sourceSize = _source->size();
 
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(size.X, size.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		_renderCommand.material().texRectUniform()->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
+		_renderCommand.material().spriteSizeUniform()->setFloatValue(size.X, size.Y);
+		_renderCommand.material().colorUniform()->setFloatVector(Colorf::White.Data());
 
-		_renderCommand.material().uniform("uPixelOffset")->setFloatValue(1.0f / size.X, 1.0f / size.Y);
-		if (!_downsampleOnly) {
-			_renderCommand.material().uniform("uDirection")->setFloatValue(_direction.X, _direction.Y);
-		}
+		// Taps are placed half a texel of the source apart, so bilinear filtering averages 4 texels per tap
+		_renderCommand.material().uniform("uPixelOffset")->setFloatValue(0.5f / sourceSize.X, 0.5f / sourceSize.Y);
 		_renderCommand.material().setTexture(0, *_source);
 
 		renderQueue.addCommand(&_renderCommand);
@@ -1663,16 +1872,15 @@ namespace Jazz2
 
 		command.material().setTexture(0, *_owner->_viewTexture);
 		command.material().setTexture(1, *_owner->_lightingBuffer);
-		command.material().setTexture(2, *_owner->_blurPass2.GetTarget());
-		command.material().setTexture(3, *_owner->_blurPass4.GetTarget());
+		command.material().setTexture(2, *_owner->_blurHalfTarget);
+		command.material().setTexture(3, *_owner->_blurQuarterTarget);
 		if (viewHasWater) {
 			command.material().setTexture(4, *_owner->_noiseTexture);
 		}
 
-		auto instanceBlock = command.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_size.X, _size.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		command.material().texRectUniform()->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+		command.material().spriteSizeUniform()->setFloatValue(_size.X, _size.Y);
+		command.material().colorUniform()->setFloatVector(Colorf::White.Data());
 
 		command.material().uniform("uAmbientColor")->setFloatVector(_owner->_ambientColor.Data());
 		command.material().uniform("uTime")->setFloatValue(_owner->_elapsedFrames * 0.0018f);
@@ -109,7 +109,8 @@ namespace Jazz2
 		void AddActor(std::shared_ptr<Actors::ActorBase> actor) override;
 
 		std::shared_ptr<AudioBufferPlayer> PlaySfx(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain = 1.0f, float pitch = 1.0f) override;
-		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
+		void RequestSfx(AudioBuffer* buffer, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
+		void PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(const std::shared_ptr<Actors::ActorBase>& actor) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, TileCollisionParams& params, Actors::ActorBase** collider) override;
 		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) override;
@@ -149,11 +150,33 @@ namespace Jazz2
 	private:
 		IRootController* _root;
 
+		/// Sound requests closer than this distance are merged into one player
+		static constexpr float SfxMergeDistance = 32.0f;
+		/// Maximum gain boost of merged sound requests
+		static constexpr float SfxMaxMergedGain = 2.0f;
+		/// Maximum number of stopped players kept for reuse
+		static constexpr int SfxPlayerPoolSize = 64;
+
+		/// Fire-and-forget sound requested in the current frame, it's started in FlushSfxRequests()
+		struct SfxRequest {
+			AudioBuffer* Buffer;
+			Vector2f Pos;
+			float Gain;
+			float Pitch;
+		};
+
 		class LightingRenderer : public SceneNode
 		{
 		public:
+			/// Vertex of a light quad, all lights are drawn from a single vertex buffer
+			struct LightVertex {
+				float X, Y;
+				float CornerX, CornerY;
+				float Intensity, Brightness, RadiusNear, RadiusFar;
+			};
+
 			LightingRenderer(LevelHandler* owner)
-				: _owner(owner), _renderCommandsCount(0)
+				: _owner(owner), _renderCommandsCount(0), _visibleLightsCount(0), _maxLightReach(DefaultMaxLightReach), _drawTime(0.0f)
 			{
 				_emittedLightsCache.reserve(32);
 				setVisitOrderState(SceneNode::VisitOrderState::Disabled);
@@ -161,11 +184,33 @@ namespace Jazz2
 
 			bool OnDraw(RenderQueue& renderQueue) override;
 
+			int GetEmittedLightCount() const
+			{
+				return (int)_emittedLightsCache.size();
+			}
+
+			int GetVisibleLightCount() const
+			{
+				return _visibleLightsCount;
+			}
+
+			float GetDrawTime() const
+			{
+				return _drawTime;
+			}
+
 		private:
+			/// Initial distance from an actor that its lights can reach, it covers all lights with fixed radius
+			static constexpr float DefaultMaxLightReach = 200.0f;
+
 			LevelHandler* _owner;
 			SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 			int _renderCommandsCount;
 			SmallVector<LightEmitter, 0> _emittedLightsCache;
+			SmallVector<LightVertex, 0> _vertices;
+			int _visibleLightsCount;
+			float _maxLightReach;
+			float _drawTime;
 
 			RenderCommand* RentRenderCommand();
 		};
@@ -179,7 +224,7 @@ namespace Jazz2
 				setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 			}
 
-			void Initialize(Texture* source, int width, int height, const Vector2f& direction);
+			void Initialize(const char* name, Texture* source, int width, int height, bool upsample);
 			void Register();
 
 			bool OnDraw(RenderQueue& renderQueue) override;
@@ -196,8 +241,7 @@ namespace Jazz2
 			RenderCommand _renderCommand;
 
 			Texture* _source;
-			bool _downsampleOnly;
-			Vector2f _direction;
+			bool _upsample;
 		};
 
 		class CombineRenderer : public SceneNode
@@ -226,16 +270,18 @@ namespace Jazz2
 		std::unique_ptr<Texture> _lightingBuffer;
 
 		Shader* _lightingShader;
-		Shader* _blurShader;
-		Shader* _downsampleShader;
+		Shader* _blurDownsampleShader;
+		Shader* _blurUpsampleShader;
 		Shader* _combineShader;
 		Shader* _combineWithWaterShader;
 
-		BlurRenderPass _downsamplePass;
-		BlurRenderPass _blurPass2;
-		BlurRenderPass _blurPass1;
-		BlurRenderPass _blurPass3;
-		BlurRenderPass _blurPass4;
+		BlurRenderPass _downsamplePass1;
+		BlurRenderPass _downsamplePass2;
+		BlurRenderPass _downsamplePass3;
+		BlurRenderPass _upsamplePass1;
+		BlurRenderPass _upsamplePass2;
+		Texture* _blurHalfTarget;
+		Texture* _blurQuarterTarget;
 		UI::UpscaleRenderPass _upscalePass;
 
 		std::unique_ptr<SceneNode> _rootNode;
@@ -268,6 +314,13 @@ namespace Jazz2
 		std::unique_ptr<Events::EventMap> _eventMap;
 		std::unique_ptr<Tiles::TileMap> _tileMap;
 		Collisions::DynamicTreeBroadPhase _collisions;
+		// Actors spawned from event map or generators, so deactivation doesn't have to walk all actors,
+		// expired entries are removed during the next deactivation check
+		SmallVector<std::weak_ptr<Actors::ActorBase>, 0> _eventActors;
+		Recti _eventActorsRange;
+		bool _eventActorsDirty;
+		uint32_t _updateFrameCounter;
+		uint32_t _actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Count];
 
 		float _elapsedFrames;
 		Rectf _viewBounds;
@@ -282,6 +335,9 @@ namespace Jazz2
 		Vector4f _ambientColor;
 		std::unique_ptr<AudioStreamPlayer> _music;
 		SmallVector<std::shared_ptr<AudioBufferPlayer>> _playingSounds;
+		SmallVector<SfxRequest, 0> _sfxRequests;
+		SmallVector<std::shared_ptr<AudioBufferPlayer>, 0> _culledSfxPlayers;
+		SmallVector<std::shared_ptr<AudioBufferPlayer>, 0> _sfxPlayerPool;
 		Metadata* _commonResources;
 		std::unique_ptr<UI::HUD> _hud;
 		std::shared_ptr<UI::Menu::InGameMenu> _pauseMenu;
@@ -301,10 +357,15 @@ namespace Jazz2
 			std::unique_ptr<Tiles::TileMap>& tileMap, std::unique_ptr<Events::EventMap>& eventMap,
 			const StringView& musicPath, const Vector4f& ambientColor, WeatherType weatherType, uint8_t weatherIntensity, SmallVectorImpl<String>& levelTexts);
 
+		void DeactivateEventActors(int tx1, int ty1, int tx2, int ty2);
+		void ScheduleActorUpdates();
 		void ResolveCollisions(float timeMult);
 		void InitializeCamera();
 		void UpdateCamera(float timeMult);
 		void UpdatePressedActions();
+		void FlushSfxRequests();
+		std::shared_ptr<AudioBufferPlayer> RentSfxPlayer(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch);
+		bool IsSfxCulled(const Vector2f& pos) const;
 
 		void PauseGame();
 		void ResumeGame();
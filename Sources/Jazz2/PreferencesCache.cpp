@@ -16,6 +16,11 @@ namespace Jazz2
 {
 	UnlockableEpisodes PreferencesCache::UnlockedEpisodes = UnlockableEpisodes::None;
 	RescaleMode PreferencesCache::ActiveRescaleMode = RescaleMode::None;
+#if !defined(DEATH_TARGET_ANDROID) && !defined(DEATH_TARGET_IOS) && !defined(DEATH_TARGET_WINDOWS_RT)
+	BlurQuality PreferencesCache::ActiveBlurQuality = BlurQuality::High;
+#else
+	BlurQuality PreferencesCache::ActiveBlurQuality = BlurQuality::Low;
+#endif
 #if defined(DEATH_TARGET_WINDOWS_RT)
 	bool PreferencesCache::EnableFullscreen = true;
 #else
@@ -45,6 +50,9 @@ namespace Jazz2
 	Vector2f PreferencesCache::TouchRightPadding;
 	uint8_t PreferencesCache::Language[4] { };
 	bool PreferencesCache::BypassCache = false;
+	bool PreferencesCache::ProfileScripts = false;
+	bool PreferencesCache::EnableAudioCapture = false;
+	String PreferencesCache::AudioCapturePath;
 	float PreferencesCache::MasterVolume = 0.8f;
 	float PreferencesCache::SfxVolume = 0.8f;
 	float PreferencesCache::MusicVolume = 0.4f;
@@ -144,6 +152,9 @@ namespace Jazz2
 						UnlockedEpisodes = (UnlockableEpisodes)uc.ReadValue<uint32_t>();
 
 						ActiveRescaleMode = (RescaleMode)uc.ReadValue<uint8_t>();
+						if (version >= 2) {
+							ActiveBlurQuality = (BlurQuality)std::min(uc.ReadValue<uint8_t>(), (uint8_t)BlurQuality::High);
+						}
 
 						MasterVolume = uc.ReadValue<uint8_t>() / 255.0f;
 						SfxVolume = uc.ReadValue<uint8_t>() / 255.0f;
@@ -249,12 +260,27 @@ namespace Jazz2
 				EnableVsync = false;
 			} else if (arg == "/no-rgb"_s) {
 				EnableRgbLights = false;
+			} else if (arg == "/no-blur"_s) {
+				ActiveBlurQuality = BlurQuality::Off;
 			} else if (arg == "/no-rescale"_s) {
 				ActiveRescaleMode = RescaleMode::None;
 			} else if (arg == "/fps"_s) {
 				ShowPerformanceMetrics = true;
 			} else if (arg == "/mute"_s) {
 				MasterVolume = 0.0f;
+			} else if (arg == "/profile-scripts"_s) {
+				ProfileScripts = true;
+			} else if (arg == "/audio-capture"_s) {
+				// Render audio output to a WAV file instead of the audio device
+				if (i + 1 < config.argc()) {
+					EnableAudioCapture = true;
+					AudioCapturePath = config.argv(i + 1);
+					i++;
+				}
+			} else if (arg == "/audio-null"_s) {
+				// Render audio output and discard it, so the audio processing can be benchmarked without any audio device
+				EnableAudioCapture = true;
+				AudioCapturePath = { };
 			}
 		}
 	}
@@ -295,6 +321,7 @@ namespace Jazz2
 		co.WriteValue<uint32_t>((uint32_t)UnlockedEpisodes);
 
 		co.WriteValue<uint8_t>((uint8_t)ActiveRescaleMode);
+		co.WriteValue<uint8_t>((uint8_t)ActiveBlurQuality);
 
 		co.WriteValue<uint8_t>((uint8_t)(MasterVolume * 255.0f));
 		co.WriteValue<uint8_t>((uint8_t)(SfxVolume * 255.0f));
@@ -25,6 +25,12 @@ namespace Jazz2
 
 	DEFINE_ENUM_OPERATORS(RescaleMode);
 
+	enum class BlurQuality : uint8_t {
+		Off,
+		Low,
+		High
+	};
+
 	enum class UnlockableEpisodes : uint32_t {
 		None = 0x00,
 
@@ -75,6 +81,7 @@ namespace Jazz2
 
 		// Graphics
 		static RescaleMode ActiveRescaleMode;
+		static BlurQuality ActiveBlurQuality;
 		static bool EnableFullscreen;
 		static bool EnableVsync;
 		static bool ShowPerformanceMetrics;
@@ -94,6 +101,9 @@ namespace Jazz2
 		static Vector2f TouchRightPadding;
 		static uint8_t Language[4];
 		static bool BypassCache;
+		static bool ProfileScripts;
+		static bool EnableAudioCapture;
+		static String AudioCapturePath;
 
 		// Sounds
 		static float MasterVolume;
@@ -127,7 +137,7 @@ namespace Jazz2
 
 		DEFINE_PRIVATE_ENUM_OPERATORS(BoolOptions);
 
-		static constexpr uint8_t FileVersion = 1;
+		static constexpr uint8_t FileVersion = 2;
 
 		static constexpr float TouchPaddingMultiplier = 0.003f;
 
@@ -6,12 +6,17 @@
 #include "RegisterString.h"
 #include "ScriptActorWrapper.h"
 #include "ScriptPlayerWrapper.h"
+#include "ScriptProfiler.h"
 
 #include "../LevelHandler.h"
 #include "../PreferencesCache.h"
 #include "../Actors/ActorBase.h"
 
+#include "../../nCine/Base/Algorithms.h"
+#include "../../nCine/Base/HashFunctions.h"
 #include "../../nCine/Base/Random.h"
+#include "../../nCine/Base/TimeStamp.h"
+#include "../../nCine/IO/IFileStream.h"
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(CMAKE_BUILD)
 #   if defined(_M_X64)
@@ -31,6 +36,8 @@
 #   endif
 #endif
 
+#include <algorithm>
+
 #if !defined(DEATH_TARGET_ANDROID) && !defined(_WIN32_WCE) && !defined(__psp2__)
 #	include <locale.h>		// setlocale()
 #endif
@@ -64,12 +71,54 @@ static float asRandom(float min, float max)
 
 namespace Jazz2::Scripting
 {
+	/// Binary stream used to save and load compiled bytecode
+	class ByteCodeFileStream : public asIBinaryStream
+	{
+	public:
+		ByteCodeFileStream(std::unique_ptr<IFileStream> s)
+			: _s(std::move(s))
+		{
+		}
+
+		int Read(void* ptr, asUINT size) override
+		{
+			return (_s->Read(ptr, size) == size ? 0 : -1);
+		}
+
+		int Write(const void* ptr, asUINT size) override
+		{
+			return (_s->Write(ptr, size) == size ? 0 : -1);
+		}
+
+	private:
+		std::unique_ptr<IFileStream> _s;
+	};
+
 	LevelScripts::LevelScripts(LevelHandler* levelHandler, const StringView& scriptPath)
 		:
 		_levelHandler(levelHandler),
 		_module(nullptr),
-		_onLevelUpdate(nullptr)
+		_onLevelBegin(nullptr),
+		_onLevelUpdate(nullptr),
+		_onLevelUpdateCoroutine(nullptr),
+		_onFunction{},
+		_onFunctionWithPlayer{},
+		_actorTypeInfo(nullptr),
+		_playerTypeInfo(nullptr),
+		_byteArrayTypeInfo(nullptr),
+		_levelLoadContext(nullptr),
+		_coroutineContext(nullptr),
+		_suspendedContext(nullptr),
+		_lineCounter(0),
+		_frameTime(0.0f),
+		_frameStats{},
+		_scriptPath(scriptPath),
+		_scriptHash(0)
 	{
+		if (PreferencesCache::ProfileScripts) {
+			_profiler = std::make_unique<ScriptProfiler>();
+		}
+
 		_engine = asCreateScriptEngine();
 		_engine->SetUserData(this, EngineToOwner);
 		_engine->SetContextCallbacks(RequestContextCallback, ReturnContextCallback, this);
@@ -170,10 +219,10 @@ enum WeatherType {
 	OutdoorsOnly = 0x80
 };
 )";
-		r = _module->AddScriptSection("__Definitions", AsDefinitionsLibrary, _countof(AsDefinitionsLibrary) - 1, 0); RETURN_ASSERT(r >= 0);
+		AddScriptSection("__Definitions"_s, AsDefinitionsLibrary, _countof(AsDefinitionsLibrary) - 1);
 
 		// Game-specific classes
-		ScriptActorWrapper::RegisterFactory(_engine, _module);
+		ScriptActorWrapper::RegisterFactory(_engine, this);
 		ScriptPlayerWrapper::RegisterFactory(_engine);
 
 		// Try to load the script
@@ -211,26 +260,51 @@ enum WeatherType {
 			return;
 		}
 
-		r = _module->Build(); RETURN_ASSERT_MSG(r >= 0, "Cannot compile the script. Please correct the code and try again.");
+		// Compilation of large scripts is slow, so try to use bytecode from the previous run if sources didn't change
+		String cachedByteCodePath = GetCachedByteCodePath();
+		TimeStamp loadStartTime = TimeStamp::now();
+		if (!PreferencesCache::BypassCache && LoadCachedByteCode(cachedByteCodePath)) {
+			LOGI_X("Script loaded from cached bytecode in %.2f ms", loadStartTime.millisecondsSince());
+		} else {
+			r = _module->Build(); RETURN_ASSERT_MSG(r >= 0, "Cannot compile the script. Please correct the code and try again.");
+			LOGI_X("Script compiled in %.2f ms", loadStartTime.millisecondsSince());
+			SaveCachedByteCode(cachedByteCodePath);
+		}
+
+		ResolveCallbacks();
 
 		asIScriptFunction* func = _module->GetFunctionByDecl("void OnLevelLoad()");
 		if (func != nullptr) {
 			asIScriptContext* ctx = _engine->RequestContext();
 
+			// Heavy initialization is expected here, so it's not aborted after MaxExecutionTime
+			_levelLoadContext = ctx;
 			ctx->Prepare(func);
-			r = ctx->Execute();
+			r = Execute(ctx);
+			_levelLoadContext = nullptr;
 			if (r == asEXECUTION_EXCEPTION) {
 				LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 			}
 
 			_engine->ReturnContext(ctx);
 		}
-
-		_onLevelUpdate = _module->GetFunctionByDecl("void OnLevelUpdate(float)");
 	}
 
 	LevelScripts::~LevelScripts()
 	{
+		if (_suspendedContext != nullptr) {
+			_suspendedContext->Abort();
+			_suspendedContext->Release();
+			_suspendedContext = nullptr;
+		}
+
+		LogFunctionStatistics();
+
+		if (_profiler != nullptr) {
+			_profiler->WriteReport(fs::JoinPath({ ContentResolver::Current().GetCachePath(), "Profiles"_s, fs::GetFileNameWithoutExtension(_scriptPath) }));
+			_profiler = nullptr;
+		}
+
 		for (auto ctx : _contextPool) {
 			ctx->Release();
 		}
@@ -393,7 +467,7 @@ enum WeatherType {
 
 		// Build the actual script
 		_engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
-		_module->AddScriptSection(path.data(), scriptContent.data(), scriptSize, 0);
+		AddScriptSection(path, scriptContent.data(), scriptSize);
 
 		if (includes.size() > 0) {
 			// Load the included scripts
@@ -407,6 +481,112 @@ enum WeatherType {
 		return true;
 	}
 
+	void LevelScripts::AddScriptSection(const StringView& name, const char* content, int length)
+	{
+		// All sections are hashed in the order they are added, so the cached bytecode can be reused only if all sources are the same
+		_scriptHash = fasthash64(name.data(), name.size(), _scriptHash);
+		_scriptHash = fasthash64(content, length, _scriptHash);
+
+		_module->AddScriptSection(String::nullTerminatedView(name).data(), content, length, 0);
+	}
+
+	String LevelScripts::GetCachedByteCodePath() const
+	{
+		// Bytecode depends also on the registered API, so include its version and the version of AngelScript in the hash
+		const uint32_t versions[] = { ApiVersion, ANGELSCRIPT_VERSION, (uint32_t)sizeof(void*) };
+		uint64_t hash = fasthash64(versions, sizeof(versions), _scriptHash);
+
+		char fileName[32];
+		formatString(fileName, sizeof(fileName), "%016llx.asbc", (unsigned long long)hash);
+		return fs::JoinPath({ ContentResolver::Current().GetCachePath(), "Scripts"_s, fileName });
+	}
+
+	bool LevelScripts::LoadCachedByteCode(const StringView& path)
+	{
+		auto s = fs::Open(path, FileAccessMode::Read);
+		if (!s->IsOpened() || s->GetSize() <= 0) {
+			return false;
+		}
+
+		// Load bytecode into a separate module, so added script sections are still available if it fails
+		asIScriptModule* cachedModule = _engine->GetModule("Cached", asGM_ALWAYS_CREATE);
+		ByteCodeFileStream stream(std::move(s));
+		int r = cachedModule->LoadByteCode(&stream);
+		if (r < 0) {
+			LOGW_X("Cannot load cached bytecode from \"%s\" with error %i, the script will be compiled again", String::nullTerminatedView(path).data(), r);
+			cachedModule->Discard();
+			return false;
+		}
+
+		_module->Discard();
+		cachedModule->SetName("Main");
+		_module = cachedModule;
+		return true;
+	}
+
+	void LevelScripts::SaveCachedByteCode(const StringView& path)
+	{
+		fs::CreateDirectories(fs::GetDirectoryName(path));
+
+		auto s = fs::Open(path, FileAccessMode::Write);
+		if (!s->IsOpened()) {
+			LOGW_X("Cannot save cached bytecode to \"%s\"", String::nullTerminatedView(path).data());
+			return;
+		}
+
+		int r;
+		{
+			ByteCodeFileStream stream(std::move(s));
+			r = _module->SaveByteCode(&stream, false);
+		}
+		if (r < 0) {
+			LOGW_X("Cannot save cached bytecode to \"%s\" with error %i", String::nullTerminatedView(path).data(), r);
+			fs::RemoveFile(path);
+		}
+	}
+
+	void LevelScripts::ResolveCallbacks()
+	{
+		_onLevelBegin = _module->GetFunctionByDecl("void OnLevelBegin()");
+		_onLevelUpdate = _module->GetFunctionByDecl("void OnLevelUpdate(float)");
+		_onLevelUpdateCoroutine = _module->GetFunctionByDecl("void OnLevelUpdateCoroutine()");
+
+		// Only functions with matching name are parsed, so it's fast even if the script contains many functions
+		char funcName[64];
+		for (asUINT i = 0; i < _module->GetFunctionCount(); i++) {
+			asIScriptFunction* func = _module->GetFunctionByIndex(i);
+			StringView name = func->GetName();
+			if (!name.hasPrefix("OnFunction"_s)) {
+				continue;
+			}
+
+			StringView number = name.exceptPrefix("OnFunction"_s);
+			if (number.empty() || number.size() > 3) {
+				continue;
+			}
+			int index = 0;
+			for (char c : number) {
+				if (c < '0' || c > '9') {
+					index = -1;
+					break;
+				}
+				index = index * 10 + (c - '0');
+			}
+			if (index < 0 || index > UINT8_MAX || _onFunction[index] != nullptr || _onFunctionWithPlayer[index] != nullptr) {
+				continue;
+			}
+
+			formatString(funcName, sizeof(funcName), "void OnFunction%i(Player@, uint8)", index);
+			_onFunctionWithPlayer[index] = _module->GetFunctionByDecl(funcName);
+			formatString(funcName, sizeof(funcName), "void OnFunction%i()", index);
+			_onFunction[index] = _module->GetFunctionByDecl(funcName);
+		}
+
+		_actorTypeInfo = _module->GetTypeInfoByName("ActorBase");
+		_playerTypeInfo = _engine->GetTypeInfoByName("Player");
+		_byteArrayTypeInfo = _engine->GetTypeInfoByDecl("array<uint8>");
+	}
+
 	int LevelScripts::ExcludeCode(String& scriptContent, int pos)
 	{
 		int scriptSize = (int)scriptContent.size();
@@ -642,7 +822,10 @@ enum WeatherType {
 			return _this->_contextPool.pop_back_val();
 		} else {
 			// No free context was available so we'll have to create a new one
-			return engine->CreateContext();
+			asIScriptContext* ctx = engine->CreateContext();
+			// Line callback is used to enforce execution time limits
+			ctx->SetLineCallback(asMETHOD(LevelScripts, OnLineCallback), _this, asCALL_THISCALL);
+			return ctx;
 		}
 	}
 
@@ -658,6 +841,123 @@ enum WeatherType {
 		_this->_contextPool.push_back(ctx);
 	}
 
+	void LevelScripts::OnLineCallback(asIScriptContext* ctx)
+	{
+		if (_profiler != nullptr) {
+			_profiler->OnLineCallback(_activeContexts);
+		}
+
+		// Checking the time on every line would be too slow
+		constexpr uint32_t LineCallbackInterval = 64;
+		if (++_lineCounter < LineCallbackInterval) {
+			return;
+		}
+		_lineCounter = 0;
+
+		float elapsed = _executionStartTime.millisecondsSince();
+		if (ctx == _coroutineContext) {
+			// Only the coroutine is suspended, the script opted in by declaring it and it continues in the next frame
+			if (_frameTime + elapsed > FrameTimeBudget) {
+				ctx->Suspend();
+			}
+		} else if (elapsed > MaxExecutionTime && _activeContexts[0] != _levelLoadContext) {
+			asIScriptFunction* func = ctx->GetFunction();
+			LOGE_X("Execution of \"%s\" took more than %i ms and was aborted. Please correct the code and try again.",
+				func != nullptr ? func->GetDeclaration() : "?", (int)MaxExecutionTime);
+			ctx->Abort();
+		}
+	}
+
+	int LevelScripts::Execute(asIScriptContext* ctx)
+	{
+		// Time is accounted to the outermost function, even if a suspended execution is resumed
+		asUINT callstackSize = ctx->GetCallstackSize();
+		asIScriptFunction* func = (callstackSize > 0 ? ctx->GetFunction(callstackSize - 1) : nullptr);
+
+		// Executions can be nested, so each of them has its own start time
+		TimeStamp prevStartTime = _executionStartTime;
+		_executionStartTime = TimeStamp::now();
+		if (_activeContexts.empty() && _profiler != nullptr) {
+			_profiler->OnExecutionStarted();
+		}
+		_activeContexts.push_back(ctx);
+
+		int r = ctx->Execute();
+
+		float elapsed = _executionStartTime.millisecondsSince();
+		_executionStartTime = prevStartTime;
+		bool isLevelLoad = (_activeContexts[0] == _levelLoadContext);
+		_activeContexts.pop_back();
+
+		if (_activeContexts.empty()) {
+			// Nested executions are already included in the time of the outer one
+			_frameTime += elapsed;
+			if (_profiler != nullptr) {
+				_profiler->OnExecutionFinished();
+			}
+		}
+
+		if (func != nullptr) {
+			auto& stats = _functionStats[func];
+			stats.TotalTime += elapsed;
+			stats.FrameTime += elapsed;
+			stats.MaxTime = std::max(stats.MaxTime, elapsed);
+			stats.CallCount++;
+
+			// Overruns are only recorded, other functions than the coroutine can't be suspended safely
+			if (elapsed > FrameTimeBudget && ctx != _coroutineContext && !isLevelLoad) {
+				if (stats.OverBudgetCount == 0) {
+					LOGW_X("Execution of \"%s\" took %.2f ms, which exceeds the frame budget of %i ms", func->GetDeclaration(), elapsed, (int)FrameTimeBudget);
+				}
+				stats.OverBudgetCount++;
+			}
+		}
+
+		return r;
+	}
+
+	void LevelScripts::BeginFrameStatistics()
+	{
+		_frameStats.TotalTime = _frameTime;
+		_frameStats.SlowestFunctionTime = 0.0f;
+		_frameStats.SlowestFunctionName = nullptr;
+		_frameStats.IsOverBudget = (_frameTime > FrameTimeBudget);
+		_frameStats.IsSuspended = (_suspendedContext != nullptr);
+		_frameTime = 0.0f;
+
+		for (auto& [func, stats] : _functionStats) {
+			if (_frameStats.SlowestFunctionTime < stats.FrameTime) {
+				_frameStats.SlowestFunctionTime = stats.FrameTime;
+				_frameStats.SlowestFunctionName = func->GetName();
+			}
+			stats.FrameTime = 0.0f;
+		}
+	}
+
+	void LevelScripts::LogFunctionStatistics()
+	{
+		if (_functionStats.empty()) {
+			return;
+		}
+
+		SmallVector<std::pair<asIScriptFunction*, FunctionStatistics>, 0> sortedStats;
+		sortedStats.reserve(_functionStats.size());
+		for (auto& [func, stats] : _functionStats) {
+			sortedStats.emplace_back(func, stats);
+		}
+		std::sort(sortedStats.begin(), sortedStats.end(), [](const auto& a, const auto& b) {
+			return (a.second.TotalTime > b.second.TotalTime);
+		});
+
+		constexpr size_t MaxLoggedFunctions = 16;
+		LOGI("Script execution times (total, average, max, calls, over budget):");
+		for (size_t i = 0; i < sortedStats.size() && i < MaxLoggedFunctions; i++) {
+			const auto& stats = sortedStats[i].second;
+			LOGI_X("  %.2f ms, %.3f ms, %.3f ms, %u, %u - %s", stats.TotalTime, stats.TotalTime / stats.CallCount,
+				stats.MaxTime, stats.CallCount, stats.OverBudgetCount, sortedStats[i].first->GetDeclaration());
+		}
+	}
+
 	void LevelScripts::Message(const asSMessageInfo& msg)
 	{
 		switch (msg.type) {
@@ -698,15 +998,14 @@ enum WeatherType {
 
 	void LevelScripts::OnLevelBegin()
 	{
-		asIScriptFunction* func = _module->GetFunctionByDecl("void OnLevelBegin()");
-		if (func == nullptr) {
+		if (_onLevelBegin == nullptr) {
 			return;
 		}
 			
 		asIScriptContext* ctx = _engine->RequestContext();
 
-		ctx->Prepare(func);
-		int r = ctx->Execute();
+		ctx->Prepare(_onLevelBegin);
+		int r = Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -716,19 +1015,54 @@ enum WeatherType {
 
 	void LevelScripts::OnLevelUpdate(float timeMult)
 	{
-		if (_onLevelUpdate == nullptr) {
-			return;
+		// OnLevelUpdate() is the first script called in each frame, so the frame budget starts here
+		BeginFrameStatistics();
+
+		if (_onLevelUpdate != nullptr) {
+			asIScriptContext* ctx = _engine->RequestContext();
+
+			ctx->Prepare(_onLevelUpdate);
+			ctx->SetArgFloat(0, timeMult);
+			int r = Execute(ctx);
+			if (r == asEXECUTION_EXCEPTION) {
+				LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
+				// Don't call the method again if an exception occurs
+				_onLevelUpdate = nullptr;
+			}
+
+			_engine->ReturnContext(ctx);
 		}
 
-		asIScriptContext* ctx = _engine->RequestContext();
+		if (_onLevelUpdateCoroutine != nullptr) {
+			ResumeLevelUpdateCoroutine();
+		}
+	}
+
+	void LevelScripts::ResumeLevelUpdateCoroutine()
+	{
+		asIScriptContext* ctx = _suspendedContext;
+		if (ctx != nullptr) {
+			// Continue where the coroutine was suspended in the previous frame
+			_suspendedContext = nullptr;
+		} else {
+			ctx = _engine->RequestContext();
+			ctx->Prepare(_onLevelUpdateCoroutine);
+		}
+
+		_coroutineContext = ctx;
+		int r = Execute(ctx);
+		_coroutineContext = nullptr;
+
+		if (r == asEXECUTION_SUSPENDED) {
+			// Keep the context out of the pool, so it can be resumed in the next frame
+			_suspendedContext = ctx;
+			return;
+		}
 
-		ctx->Prepare(_onLevelUpdate);
-		ctx->SetArgFloat(0, timeMult);
-		int r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 			// Don't call the method again if an exception occurs
-			_onLevelUpdate = nullptr;
+			_onLevelUpdateCoroutine = nullptr;
 		}
 
 		_engine->ReturnContext(ctx);
@@ -736,14 +1070,19 @@ enum WeatherType {
 
 	void LevelScripts::OnLevelCallback(Actors::ActorBase* initiator, uint8_t* eventParams)
 	{
-		char funcName[64];
 		asIScriptFunction* func;
 
 		// If known player is the initiator, try to call specific variant of the function
-		if (auto player = dynamic_cast<Actors::Player*>(initiator)) {
-			formatString(funcName, sizeof(funcName), "void OnFunction%i(Player@, uint8)", eventParams[0]);
-			func = _module->GetFunctionByDecl(funcName);
-			if (func != nullptr) {
+		func = _onFunctionWithPlayer[eventParams[0]];
+		if (func != nullptr) {
+			Actors::Player* player = nullptr;
+			for (auto* p : _levelHandler->_players) {
+				if (p == initiator) {
+					player = p;
+					break;
+				}
+			}
+			if (player != nullptr) {
 				asIScriptContext* ctx = _engine->RequestContext();
 
 				void* mem = asAllocMem(sizeof(ScriptPlayerWrapper));
@@ -752,7 +1091,7 @@ enum WeatherType {
 				ctx->Prepare(func);
 				ctx->SetArgObject(0, playerWrapper);
 				ctx->SetArgByte(1, eventParams[1]);
-				int r = ctx->Execute();
+				int r = Execute(ctx);
 				if (r == asEXECUTION_EXCEPTION) {
 					LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 				}
@@ -765,13 +1104,12 @@ enum WeatherType {
 		}
 
 		// Try to call parameter-less variant
-		formatString(funcName, sizeof(funcName), "void OnFunction%i()", eventParams[0]);
-		func = _module->GetFunctionByDecl(funcName);
+		func = _onFunction[eventParams[0]];
 		if (func != nullptr) {
 			asIScriptContext* ctx = _engine->RequestContext();
 
 			ctx->Prepare(func);
-			int r = ctx->Execute();
+			int r = Execute(ctx);
 			if (r == asEXECUTION_EXCEPTION) {
 				LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 			}
@@ -780,7 +1118,7 @@ enum WeatherType {
 			return;
 		}
 
-		LOGW_X("Callback function \"%s\" was not found in the script. Please correct the code and try again.", funcName);
+		LOGW_X("Callback function \"OnFunction%i\" was not found in the script. Please correct the code and try again.", eventParams[0]);
 	}
 
 	uint8_t LevelScripts::asGetDifficulty()
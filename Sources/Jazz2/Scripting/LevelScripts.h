@@ -5,15 +5,24 @@
 #include "FindAngelScript.h"
 #include "../ILevelHandler.h"
 
+#include "../../nCine/Base/TimeStamp.h"
+
 namespace Jazz2::Scripting
 {
 	class CScriptArray;
 	class ScriptActorWrapper;
+	class ScriptProfiler;
 
 	class LevelScripts
 	{
 	public:
 		static constexpr asPWORD EngineToOwner = 0;
+		/// Time in milliseconds that scripts should spend in one frame, only `OnLevelUpdateCoroutine()` is suspended if it exceeds it
+		static constexpr float FrameTimeBudget = 4.0f;
+		/// Time in milliseconds after that script execution is aborted (except `OnLevelLoad()`), it protects against infinite loops
+		static constexpr float MaxExecutionTime = 250.0f;
+		/// Version of the registered script API, it has to be increased if the registered functions change to invalidate cached bytecode (built-in sections are hashed)
+		static constexpr uint32_t ApiVersion = 1;
 
 		LevelScripts(LevelHandler* levelHandler, const StringView& scriptPath);
 		~LevelScripts();
@@ -26,23 +35,88 @@ namespace Jazz2::Scripting
 			return _module;
 		}
 
+		asITypeInfo* GetActorTypeInfo() const {
+			return _actorTypeInfo;
+		}
+
+		asITypeInfo* GetPlayerTypeInfo() const {
+			return _playerTypeInfo;
+		}
+
+		asITypeInfo* GetByteArrayTypeInfo() const {
+			return _byteArrayTypeInfo;
+		}
+
 		const SmallVectorImpl<Actors::Player*>& GetPlayers() const;
 
 		void OnLevelBegin();
 		void OnLevelUpdate(float timeMult);
 		void OnLevelCallback(Actors::ActorBase* initiator, uint8_t* eventParams);
 
+		/// Executes prepared context and measures its execution time
+		int Execute(asIScriptContext* ctx);
+		/// Adds a section to the main module, it's included in the hash that validates cached bytecode
+		void AddScriptSection(const StringView& name, const char* content, int length);
+
+		/// Script execution statistics of the last frame
+		struct FrameStatistics {
+			float TotalTime;
+			float SlowestFunctionTime;
+			const char* SlowestFunctionName;
+			bool IsOverBudget;
+			bool IsSuspended;
+		};
+
+		const FrameStatistics& GetFrameStatistics() const {
+			return _frameStats;
+		}
+
 	private:
+		struct FunctionStatistics {
+			float TotalTime;
+			float FrameTime;
+			float MaxTime;
+			uint32_t CallCount;
+			uint32_t OverBudgetCount;
+		};
+
 		LevelHandler* _levelHandler;
 		asIScriptEngine* _engine;
 		asIScriptModule* _module;
 		SmallVector<asIScriptContext*, 4> _contextPool;
 
+		asIScriptFunction* _onLevelBegin;
 		asIScriptFunction* _onLevelUpdate;
+		asIScriptFunction* _onLevelUpdateCoroutine;
+		// Callback functions indexed by function number, they are resolved only once after the script is loaded
+		asIScriptFunction* _onFunction[UINT8_MAX + 1];
+		asIScriptFunction* _onFunctionWithPlayer[UINT8_MAX + 1];
+
+		asITypeInfo* _actorTypeInfo;
+		asITypeInfo* _playerTypeInfo;
+		asITypeInfo* _byteArrayTypeInfo;
+
+		asIScriptContext* _levelLoadContext;
+		asIScriptContext* _coroutineContext;
+		asIScriptContext* _suspendedContext;
+		TimeStamp _executionStartTime;
+		SmallVector<asIScriptContext*, 4> _activeContexts;
+		uint32_t _lineCounter;
+		float _frameTime;
+		FrameStatistics _frameStats;
+		HashMap<asIScriptFunction*, FunctionStatistics> _functionStats;
+		std::unique_ptr<ScriptProfiler> _profiler;
+		String _scriptPath;
 
 		HashMap<int, asITypeInfo*> _eventTypeToTypeInfo;
+		uint64_t _scriptHash;
 
 		bool AddScriptFromFile(const StringView& path, const HashMap<String, bool>& definedSymbols);
+		String GetCachedByteCodePath() const;
+		bool LoadCachedByteCode(const StringView& path);
+		void SaveCachedByteCode(const StringView& path);
+		void ResolveCallbacks();
+		void ResumeLevelUpdateCoroutine();
 		int ExcludeCode(String& scriptContent, int pos);
 		int SkipStatement(String& scriptContent, int pos);
 		void ProcessPragma(const StringView& content);
@@ -50,6 +124,9 @@ namespace Jazz2::Scripting
 
 		static asIScriptContext* RequestContextCallback(asIScriptEngine* engine, void* param);
 		static void ReturnContextCallback(asIScriptEngine* engine, asIScriptContext* ctx, void* param);
+		void OnLineCallback(asIScriptContext* ctx);
+		void BeginFrameStatistics();
+		void LogFunctionStatistics();
 
 		void Message(const asSMessageInfo& msg);
 		Actors::ActorBase* CreateActorInstance(const StringView& typeName);
@@ -24,6 +24,9 @@ using namespace Jazz2::Actors;
 
 namespace Jazz2::Scripting
 {
+	// Add-ons have reserved the numbers 1000 through 1999 for type user data (see RegisterArray.cpp), so the first free one is used
+	constexpr asPWORD ActorMethodsUserData = 2000;
+
 	ScriptActorWrapper::ScriptActorWrapper(LevelScripts* levelScripts, asIScriptObject* obj)
 		:
 		_levelScripts(levelScripts),
@@ -34,16 +37,40 @@ namespace Jazz2::Scripting
 		_isDead = obj->GetWeakRefFlag();
 		_isDead->AddRef();
 
-		_onTileDeactivated = _obj->GetObjectType()->GetMethodByDecl("bool OnTileDeactivated()");
-		_onHealthChanged = _obj->GetObjectType()->GetMethodByDecl("void OnHealthChanged()");
-		_onUpdate = _obj->GetObjectType()->GetMethodByDecl("void OnUpdate(float)");
-		_onUpdateHitbox = _obj->GetObjectType()->GetMethodByDecl("void OnUpdateHitbox()");
-		_onHandleCollision = _obj->GetObjectType()->GetMethodByDecl("bool OnHandleCollision(ref other)");
-		_onHitFloor = _obj->GetObjectType()->GetMethodByDecl("void OnHitFloor(float)");
-		_onHitCeiling = _obj->GetObjectType()->GetMethodByDecl("void OnHitCeiling(float)");
-		_onHitWall = _obj->GetObjectType()->GetMethodByDecl("void OnHitWall(float)");
-		_onAnimationStarted = _obj->GetObjectType()->GetMethodByDecl("void OnAnimationStarted()");
-		_onAnimationFinished = _obj->GetObjectType()->GetMethodByDecl("void OnAnimationFinished()");
+		_methods = GetMethods(_obj->GetObjectType());
+	}
+
+	const ScriptActorMethods* ScriptActorWrapper::GetMethods(asITypeInfo* typeInfo)
+	{
+		auto methods = reinterpret_cast<ScriptActorMethods*>(typeInfo->GetUserData(ActorMethodsUserData));
+		if (methods == nullptr) {
+			// Parsing of declarations is slow, so it's done only for the first instance of each type
+			methods = new(asAllocMem(sizeof(ScriptActorMethods))) ScriptActorMethods();
+			methods->OnActivated = typeInfo->GetMethodByDecl("bool OnActivated(array<uint8> &in)");
+			methods->OnTileDeactivated = typeInfo->GetMethodByDecl("bool OnTileDeactivated()");
+			methods->OnHealthChanged = typeInfo->GetMethodByDecl("void OnHealthChanged()");
+			methods->OnPerish = typeInfo->GetMethodByDecl("bool OnPerish()");
+			methods->OnUpdate = typeInfo->GetMethodByDecl("void OnUpdate(float)");
+			methods->OnUpdateHitbox = typeInfo->GetMethodByDecl("void OnUpdateHitbox()");
+			methods->OnHandleCollision = typeInfo->GetMethodByDecl("bool OnHandleCollision(ref other)");
+			methods->OnHitFloor = typeInfo->GetMethodByDecl("void OnHitFloor(float)");
+			methods->OnHitCeiling = typeInfo->GetMethodByDecl("void OnHitCeiling(float)");
+			methods->OnHitWall = typeInfo->GetMethodByDecl("void OnHitWall(float)");
+			methods->OnAnimationStarted = typeInfo->GetMethodByDecl("void OnAnimationStarted()");
+			methods->OnAnimationFinished = typeInfo->GetMethodByDecl("void OnAnimationFinished()");
+			methods->OnCollect = typeInfo->GetMethodByDecl("bool OnCollect(Player@)");
+			typeInfo->SetUserData(methods, ActorMethodsUserData);
+		}
+		return methods;
+	}
+
+	void ScriptActorWrapper::CleanupTypeInfoMethods(asITypeInfo* typeInfo)
+	{
+		auto methods = reinterpret_cast<ScriptActorMethods*>(typeInfo->GetUserData(ActorMethodsUserData));
+		if (methods != nullptr) {
+			methods->~ScriptActorMethods();
+			asFreeMem(methods);
+		}
 	}
 
 	ScriptActorWrapper::~ScriptActorWrapper()
@@ -54,7 +81,7 @@ namespace Jazz2::Scripting
 		_isDead->Release();
 	}
 
-	void ScriptActorWrapper::RegisterFactory(asIScriptEngine* engine, asIScriptModule* module)
+	void ScriptActorWrapper::RegisterFactory(asIScriptEngine* engine, LevelScripts* levelScripts)
 	{
 		constexpr char AsLibrary[] = R"(
 shared abstract class )" AsClassName R"(
@@ -142,6 +169,8 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 }
 )";
 		int r;
+		engine->SetTypeInfoUserDataCleanupCallback(CleanupTypeInfoMethods, ActorMethodsUserData);
+
 		r = engine->RegisterObjectType(AsClassNameInternal, 0, asOBJ_REF); RETURN_ASSERT(r >= 0);
 		r = engine->RegisterObjectBehaviour(AsClassNameInternal, asBEHAVE_FACTORY, AsClassNameInternal " @f(int)", asFUNCTION(ScriptActorWrapper::Factory), asCALL_CDECL); RETURN_ASSERT(r >= 0);
 		r = engine->RegisterObjectBehaviour(AsClassNameInternal, asBEHAVE_ADDREF, "void f()", asMETHOD(ScriptActorWrapper, AddRef), asCALL_THISCALL); RETURN_ASSERT(r >= 0);
@@ -173,7 +202,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		r = engine->RegisterObjectMethod(AsClassNameInternal, "void SetAnimation(const string &in)", asMETHOD(ScriptActorWrapper, asSetAnimation), asCALL_THISCALL); RETURN_ASSERT(r >= 0);
 		r = engine->RegisterObjectMethod(AsClassNameInternal, "void SetAnimation(int)", asMETHOD(ScriptActorWrapper, asSetAnimationState), asCALL_THISCALL); RETURN_ASSERT(r >= 0);
 
-		r = module->AddScriptSection("__" AsClassName, AsLibrary, _countof(AsLibrary) - 1, 0); RETURN_ASSERT(r >= 0);
+		levelScripts->AddScriptSection(StringView("__" AsClassName), AsLibrary, _countof(AsLibrary) - 1);
 	}
 
 	ScriptActorWrapper* ScriptActorWrapper::Factory(int actorType)
@@ -230,22 +259,21 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 			async_return false;
 		}
 
-		asIScriptEngine* engine = _obj->GetEngine();
-		asIScriptFunction* func = _obj->GetObjectType()->GetMethodByDecl("bool OnActivated(array<uint8> &in)");
-		if (func == nullptr) {
+		if (_methods->OnActivated == nullptr) {
 			async_return false;
 		}
 
-		SetState(ActorState::CollideWithOtherActors, _onHandleCollision != nullptr);
+		SetState(ActorState::CollideWithOtherActors, _methods->OnHandleCollision != nullptr);
 
-		CScriptArray* eventParams = CScriptArray::Create(engine->GetTypeInfoByDecl("array<uint8>"), Events::EventSpawner::SpawnParamsSize);
+		CScriptArray* eventParams = CScriptArray::Create(_levelScripts->GetByteArrayTypeInfo(), Events::EventSpawner::SpawnParamsSize);
 		std::memcpy(eventParams->At(0), details.Params, Events::EventSpawner::SpawnParamsSize);
 
+		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
-		ctx->Prepare(func);
+		ctx->Prepare(_methods->OnActivated);
 		ctx->SetObject(_obj);
 		ctx->SetArgObject(0, eventParams);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		bool result;
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
@@ -262,16 +290,16 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	bool ScriptActorWrapper::OnTileDeactivated()
 	{
-		if (_onTileDeactivated == nullptr || _isDead->Get()) {
+		if (_methods->OnTileDeactivated == nullptr || _isDead->Get()) {
 			return true;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onTileDeactivated);
+		ctx->Prepare(_methods->OnTileDeactivated);
 		ctx->SetObject(_obj);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		bool result;
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
@@ -287,16 +315,16 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnHealthChanged(ActorBase* collider)
 	{
-		if (_onHealthChanged == nullptr || _isDead->Get()) {
+		if (_methods->OnHealthChanged == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onHealthChanged);
+		ctx->Prepare(_methods->OnHealthChanged);
 		ctx->SetObject(_obj);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -310,17 +338,16 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 			return ActorBase::OnPerish(collider);
 		}
 
-		asIScriptFunction* func = _obj->GetObjectType()->GetMethodByDecl("bool OnPerish()");
-		if (func == nullptr) {
+		if (_methods->OnPerish == nullptr) {
 			return ActorBase::OnPerish(collider);
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(func);
+		ctx->Prepare(_methods->OnPerish);
 		ctx->SetObject(_obj);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		bool result;
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
@@ -336,17 +363,17 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnUpdate(float timeMult)
 	{
-		if (_onUpdate == nullptr || _isDead->Get()) {
+		if (_methods->OnUpdate == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onUpdate);
+		ctx->Prepare(_methods->OnUpdate);
 		ctx->SetObject(_obj);
 		ctx->SetArgFloat(0, timeMult);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -356,7 +383,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnUpdateHitbox()
 	{
-		if (_onUpdateHitbox == nullptr || _isDead->Get()) {
+		if (_methods->OnUpdateHitbox == nullptr || _isDead->Get()) {
 			// Call base implementation if not overriden
 			ActorBase::OnUpdateHitbox();
 			return;
@@ -365,9 +392,9 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onUpdateHitbox);
+		ctx->Prepare(_methods->OnUpdateHitbox);
 		ctx->SetObject(_obj);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -377,18 +404,18 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	bool ScriptActorWrapper::OnHandleCollision(std::shared_ptr<ActorBase> other)
 	{
-		if (_onHandleCollision != nullptr) {
+		if (_methods->OnHandleCollision != nullptr) {
 			if (auto otherWrapper = dynamic_cast<ScriptActorWrapper*>(other.get())) {
 				asIScriptEngine* engine = _obj->GetEngine();
-				asITypeInfo* typeInfo = _levelScripts->GetMainModule()->GetTypeInfoByName(AsClassName);
+				asITypeInfo* typeInfo = _levelScripts->GetActorTypeInfo();
 				if (typeInfo != nullptr) {
 					asIScriptContext* ctx = engine->RequestContext();
 
 					CScriptHandle handle(otherWrapper->_obj, typeInfo);
-					ctx->Prepare(_onHandleCollision);
+					ctx->Prepare(_methods->OnHandleCollision);
 					ctx->SetObject(_obj);
 					int p = ctx->SetArgObject(0, &handle);
-					int r = ctx->Execute();
+					int r = _levelScripts->Execute(ctx);
 					bool result;
 					if (r == asEXECUTION_EXCEPTION) {
 						LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
@@ -405,7 +432,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 				}
 			} else if (auto player = dynamic_cast<Player*>(other.get())) {
 				asIScriptEngine* engine = _obj->GetEngine();
-				asITypeInfo* typeInfo = engine->GetTypeInfoByName("Player");
+				asITypeInfo* typeInfo = _levelScripts->GetPlayerTypeInfo();
 				if (typeInfo != nullptr) {
 					asIScriptContext* ctx = engine->RequestContext();
 
@@ -413,10 +440,10 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 					ScriptPlayerWrapper* playerWrapper = new(mem) ScriptPlayerWrapper(_levelScripts, player);
 
 					CScriptHandle handle(playerWrapper, typeInfo);
-					ctx->Prepare(_onHandleCollision);
+					ctx->Prepare(_methods->OnHandleCollision);
 					ctx->SetObject(_obj);
 					int p = ctx->SetArgObject(0, &handle);
-					int r = ctx->Execute();
+					int r = _levelScripts->Execute(ctx);
 					bool result;
 					if (r == asEXECUTION_EXCEPTION) {
 						LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
@@ -447,17 +474,17 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnHitFloor(float timeMult)
 	{
-		if (_onHitFloor == nullptr || _isDead->Get()) {
+		if (_methods->OnHitFloor == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onHitFloor);
+		ctx->Prepare(_methods->OnHitFloor);
 		ctx->SetObject(_obj);
 		ctx->SetArgFloat(0, timeMult);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -467,17 +494,17 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnHitCeiling(float timeMult)
 	{
-		if (_onHitCeiling == nullptr || _isDead->Get()) {
+		if (_methods->OnHitCeiling == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onHitCeiling);
+		ctx->Prepare(_methods->OnHitCeiling);
 		ctx->SetObject(_obj);
 		ctx->SetArgFloat(0, timeMult);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -487,17 +514,17 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnHitWall(float timeMult)
 	{
-		if (_onHitWall == nullptr || _isDead->Get()) {
+		if (_methods->OnHitWall == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onHitWall);
+		ctx->Prepare(_methods->OnHitWall);
 		ctx->SetObject(_obj);
 		ctx->SetArgFloat(0, timeMult);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -507,16 +534,16 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::OnAnimationStarted()
 	{
-		if (_onAnimationStarted == nullptr || _isDead->Get()) {
+		if (_methods->OnAnimationStarted == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onAnimationStarted);
+		ctx->Prepare(_methods->OnAnimationStarted);
 		ctx->SetObject(_obj);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -529,16 +556,16 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		// Always call base implementation
 		ActorBase::OnAnimationFinished();
 
-		if (_onAnimationFinished == nullptr || _isDead->Get()) {
+		if (_methods->OnAnimationFinished == nullptr || _isDead->Get()) {
 			return;
 		}
 
 		asIScriptEngine* engine = _obj->GetEngine();
 		asIScriptContext* ctx = engine->RequestContext();
 
-		ctx->Prepare(_onAnimationFinished);
+		ctx->Prepare(_methods->OnAnimationFinished);
 		ctx->SetObject(_obj);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
 		}
@@ -594,7 +621,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	void ScriptActorWrapper::asPlaySfx(const String& identifier, float gain, float pitch)
 	{
-		PlaySfx(identifier, gain, pitch);
+		RequestSfx(identifier, gain, pitch);
 	}
 
 	void ScriptActorWrapper::asSetAnimation(const String& identifier)
@@ -615,7 +642,6 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		_timeLeft(0.0f),
 		_startingY(0.0f)
 	{
-		_onCollect = _obj->GetObjectType()->GetMethodByDecl("bool OnCollect(Player@)");
 	}
 
 	Task<bool> ScriptCollectibleWrapper::OnActivatedAsync(const ActorActivationDetails& details)
@@ -668,7 +694,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 
 	bool ScriptCollectibleWrapper::OnCollect(Player* player)
 	{
-		if (_onCollect == nullptr || _isDead->Get()) {
+		if (_methods->OnCollect == nullptr || _isDead->Get()) {
 			return false;
 		}
 
@@ -678,10 +704,10 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		void* mem = asAllocMem(sizeof(ScriptPlayerWrapper));
 		ScriptPlayerWrapper* playerWrapper = new(mem) ScriptPlayerWrapper(_levelScripts, player);
 
-		ctx->Prepare(_onCollect);
+		ctx->Prepare(_methods->OnCollect);
 		ctx->SetObject(_obj);
 		ctx->SetArgObject(0, playerWrapper);
-		int r = ctx->Execute();
+		int r = _levelScripts->Execute(ctx);
 		bool result;
 		if (r == asEXECUTION_EXCEPTION) {
 			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
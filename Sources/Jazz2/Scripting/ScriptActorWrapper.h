@@ -9,6 +9,7 @@ class asIScriptEngine;
 class asIScriptModule;
 class asIScriptObject;
 class asIScriptFunction;
+class asITypeInfo;
 class asILockableSharedBool;
 
 namespace Jazz2::Actors
@@ -20,13 +21,31 @@ namespace Jazz2::Scripting
 {
 	class LevelScripts;
 
+	/// Script methods of a script actor type, they are resolved only once per type
+	struct ScriptActorMethods
+	{
+		asIScriptFunction* OnActivated;
+		asIScriptFunction* OnTileDeactivated;
+		asIScriptFunction* OnHealthChanged;
+		asIScriptFunction* OnPerish;
+		asIScriptFunction* OnUpdate;
+		asIScriptFunction* OnUpdateHitbox;
+		asIScriptFunction* OnHandleCollision;
+		asIScriptFunction* OnHitFloor;
+		asIScriptFunction* OnHitCeiling;
+		asIScriptFunction* OnHitWall;
+		asIScriptFunction* OnAnimationStarted;
+		asIScriptFunction* OnAnimationFinished;
+		asIScriptFunction* OnCollect;
+	};
+
 	class ScriptActorWrapper : public Actors::ActorBase
 	{
 	public:
 		ScriptActorWrapper(LevelScripts* levelScripts, asIScriptObject* obj);
 		~ScriptActorWrapper();
 
-		static void RegisterFactory(asIScriptEngine* engine, asIScriptModule* module);
+		static void RegisterFactory(asIScriptEngine* engine, LevelScripts* levelScripts);
 		static ScriptActorWrapper* Factory(int actorType);
 
 		void AddRef();
@@ -46,6 +65,7 @@ namespace Jazz2::Scripting
 		LevelScripts* _levelScripts;
 		asIScriptObject* _obj;
 		asILockableSharedBool* _isDead;
+		const ScriptActorMethods* _methods;
 
 		uint32_t _scoreValue;
 
@@ -84,16 +104,8 @@ namespace Jazz2::Scripting
 	private:
 		int _refCount;
 
-		asIScriptFunction* _onTileDeactivated;
-		asIScriptFunction* _onHealthChanged;
-		asIScriptFunction* _onUpdate;
-		asIScriptFunction* _onUpdateHitbox;
-		asIScriptFunction* _onHandleCollision;
-		asIScriptFunction* _onHitFloor;
-		asIScriptFunction* _onHitCeiling;
-		asIScriptFunction* _onHitWall;
-		asIScriptFunction* _onAnimationStarted;
-		asIScriptFunction* _onAnimationFinished;
+		static const ScriptActorMethods* GetMethods(asITypeInfo* typeInfo);
+		static void CleanupTypeInfoMethods(asITypeInfo* typeInfo);
 	};
 
 	class ScriptCollectibleWrapper : public ScriptActorWrapper
@@ -112,8 +124,6 @@ namespace Jazz2::Scripting
 		bool _untouched;
 		float _phase, _timeLeft;
 		float _startingY;
-
-		asIScriptFunction* _onCollect;
 	};
 }
 
@@ -0,0 +1,192 @@
+﻿#if defined(WITH_ANGELSCRIPT)
+
+#include "ScriptProfiler.h"
+
+#include "../../nCine/Base/Algorithms.h"
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include <algorithm>
+
+namespace Jazz2::Scripting
+{
+	ScriptProfiler::ScriptProfiler()
+		: _pendingTime(0.0f), _totalTime(0.0f), _sampleCount(0)
+	{
+	}
+
+	void ScriptProfiler::OnExecutionStarted()
+	{
+		// Time between executions doesn't belong to any script function
+		_lastSampleTime = TimeStamp::now();
+	}
+
+	void ScriptProfiler::OnExecutionFinished()
+	{
+		// The rest of the execution is accounted to the next sample, so it's not lost
+		_pendingTime += _lastSampleTime.millisecondsSince();
+	}
+
+	void ScriptProfiler::OnLineCallback(const SmallVectorImpl<asIScriptContext*>& activeContexts)
+	{
+		if (activeContexts.empty()) {
+			return;
+		}
+
+		// Script time is accumulated across executions, so many short executions are sampled too
+		TimeStamp now = TimeStamp::now();
+		_pendingTime += (now - _lastSampleTime).milliseconds();
+		_lastSampleTime = now;
+		if (_pendingTime < SampleInterval) {
+			return;
+		}
+
+		// Time since the last sample is accounted to the current call stack, including nested executions
+		_currentStack.clear();
+		for (asIScriptContext* ctx : activeContexts) {
+			for (asUINT i = ctx->GetCallstackSize(); i > 0; i--) {
+				asIScriptFunction* func = ctx->GetFunction(i - 1);
+				if (func != nullptr) {
+					_currentStack.push_back(func);
+				}
+			}
+		}
+		if (_currentStack.empty()) {
+			return;
+		}
+
+		float elapsed = _pendingTime;
+		_pendingTime = 0.0f;
+		_totalTime += elapsed;
+		_sampleCount++;
+
+		String stackKey;
+		for (std::size_t i = 0; i < _currentStack.size(); i++) {
+			asIScriptFunction* func = _currentStack[i];
+			auto& samples = GetFunctionSamples(func);
+
+			// Recursive functions are counted only once per sample
+			bool isRecursive = false;
+			for (std::size_t j = 0; j < i; j++) {
+				if (_currentStack[j] == func) {
+					isRecursive = true;
+					break;
+				}
+			}
+			if (!isRecursive) {
+				samples.TotalTime += elapsed;
+			}
+
+			stackKey = (i == 0 ? String(samples.Name) : stackKey + ";"_s + samples.Name);
+		}
+
+		asIScriptFunction* topFunc = _currentStack.back();
+		GetFunctionSamples(topFunc).SelfTime += elapsed;
+		_stacks[stackKey] += elapsed;
+
+		const char* section = nullptr;
+		int line = activeContexts.back()->GetLineNumber(0, nullptr, &section);
+		uint64_t lineKey = ((uint64_t)(uint32_t)topFunc->GetId() << 32) | (uint32_t)line;
+		auto it = _lines.find(lineKey);
+		if (it == _lines.end()) {
+			it = _lines.emplace(lineKey, LineSamples { topFunc, section, line, 0.0f }).first;
+		}
+		it->second.SelfTime += elapsed;
+	}
+
+	void ScriptProfiler::WriteReport(const StringView& path)
+	{
+		if (_sampleCount == 0) {
+			return;
+		}
+
+		SmallVector<const FunctionSamples*, 0> sortedFunctions;
+		sortedFunctions.reserve(_functions.size());
+		for (auto& [func, samples] : _functions) {
+			sortedFunctions.push_back(&samples);
+		}
+		std::sort(sortedFunctions.begin(), sortedFunctions.end(), [](const FunctionSamples* a, const FunctionSamples* b) {
+			return (a->SelfTime > b->SelfTime);
+		});
+
+		SmallVector<const LineSamples*, 0> sortedLines;
+		sortedLines.reserve(_lines.size());
+		for (auto& [key, samples] : _lines) {
+			sortedLines.push_back(&samples);
+		}
+		std::sort(sortedLines.begin(), sortedLines.end(), [](const LineSamples* a, const LineSamples* b) {
+			return (a->SelfTime > b->SelfTime);
+		});
+
+		String reportPath = path + ".txt"_s;
+		String stacksPath = path + ".folded"_s;
+		fs::CreateDirectories(fs::GetDirectoryName(path));
+		auto reportFile = fs::Open(reportPath, FileAccessMode::Write);
+		bool hasReportFile = reportFile->IsOpened();
+
+		char line[512];
+		auto writeLine = [&](bool log, int length) {
+			if (log) {
+				LOGI_X("%s", line);
+			}
+			if (hasReportFile && length > 0) {
+				reportFile->Write(line, (uint32_t)std::min(length, (int)sizeof(line) - 1));
+				reportFile->Write("\n", 1);
+			}
+		};
+
+		// Only the most expensive entries are written to the log, the file contains all of them
+		constexpr std::size_t MaxLoggedEntries = 20;
+
+		writeLine(true, formatString(line, sizeof(line), "Script profile: %u samples, %.2f ms in scripts", _sampleCount, _totalTime));
+		writeLine(true, formatString(line, sizeof(line), "Functions (self, total):"));
+		for (std::size_t i = 0; i < sortedFunctions.size(); i++) {
+			const auto* samples = sortedFunctions[i];
+			writeLine(i < MaxLoggedEntries, formatString(line, sizeof(line), "  %8.2f ms %5.1f%%  %8.2f ms %5.1f%%  %s",
+				samples->SelfTime, samples->SelfTime * 100.0f / _totalTime, samples->TotalTime, samples->TotalTime * 100.0f / _totalTime, samples->Name.data()));
+		}
+
+		writeLine(true, formatString(line, sizeof(line), "Lines (self):"));
+		for (std::size_t i = 0; i < sortedLines.size(); i++) {
+			const auto* samples = sortedLines[i];
+			writeLine(i < MaxLoggedEntries, formatString(line, sizeof(line), "  %8.2f ms %5.1f%%  %s:%i  %s",
+				samples->SelfTime, samples->SelfTime * 100.0f / _totalTime, samples->Section != nullptr ? samples->Section : "?",
+				samples->Line, GetFunctionSamples(samples->Function).Name.data()));
+		}
+
+		if (hasReportFile) {
+			reportFile->Close();
+			LOGI_X("Script profile report was saved to \"%s\"", reportPath.data());
+		}
+
+		// Collapsed stacks can be used directly by flamegraph.pl or speedscope, values are in microseconds
+		auto stacksFile = fs::Open(stacksPath, FileAccessMode::Write);
+		if (stacksFile->IsOpened()) {
+			for (auto& [stack, time] : _stacks) {
+				int length = formatString(line, sizeof(line), " %u\n", (uint32_t)(time * 1000.0f));
+				stacksFile->Write(stack.data(), (uint32_t)stack.size());
+				stacksFile->Write(line, (uint32_t)length);
+			}
+			stacksFile->Close();
+			LOGI_X("Script profile collapsed stacks were saved to \"%s\"", stacksPath.data());
+		}
+	}
+
+	ScriptProfiler::FunctionSamples& ScriptProfiler::GetFunctionSamples(asIScriptFunction* func)
+	{
+		auto it = _functions.find(func);
+		if (it == _functions.end()) {
+			// Declarations are used as names, but semicolons are reserved by the collapsed stack format
+			String name = func->GetDeclaration(true, true, false);
+			for (char& c : name) {
+				if (c == ';') {
+					c = ',';
+				}
+			}
+			it = _functions.emplace(func, FunctionSamples { std::move(name), 0.0f, 0.0f }).first;
+		}
+		return it->second;
+	}
+}
+
+#endif
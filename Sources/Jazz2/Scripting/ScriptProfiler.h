@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#if defined(WITH_ANGELSCRIPT)
+
+#include "FindAngelScript.h"
+#include "../ILevelHandler.h"
+
+#include "../../nCine/Base/TimeStamp.h"
+
+namespace Jazz2::Scripting
+{
+	/// Sampling profiler of script functions
+	/*! Samples are taken from the line callback of the executing contexts, so only time spent in scripts is measured.
+	 *  The report is written to the log and to files, so it can be used also in headless runs. */
+	class ScriptProfiler
+	{
+	public:
+		/// Minimum script time in milliseconds between two samples
+		static constexpr float SampleInterval = 0.25f;
+
+		ScriptProfiler();
+
+		/// Should be called before the outermost script execution starts
+		void OnExecutionStarted();
+		/// Should be called after the outermost script execution finishes
+		void OnExecutionFinished();
+		/// Should be called from the line callback, contexts are ordered from the outermost to the innermost one
+		void OnLineCallback(const SmallVectorImpl<asIScriptContext*>& activeContexts);
+
+		/// Writes the report sorted by self time to the log and to "<path>.txt", and collapsed stacks to "<path>.folded"
+		void WriteReport(const StringView& path);
+
+	private:
+		struct FunctionSamples {
+			String Name;
+			float SelfTime;
+			float TotalTime;
+		};
+
+		struct LineSamples {
+			asIScriptFunction* Function;
+			const char* Section;
+			int Line;
+			float SelfTime;
+		};
+
+		TimeStamp _lastSampleTime;
+		float _pendingTime;
+		float _totalTime;
+		uint32_t _sampleCount;
+		HashMap<asIScriptFunction*, FunctionSamples> _functions;
+		HashMap<uint64_t, LineSamples> _lines;
+		HashMap<String, float> _stacks;
+		SmallVector<asIScriptFunction*, 32> _currentStack;
+
+		FunctionSamples& GetFunctionSamples(asIScriptFunction* func);
+	};
+}
+
+#endif
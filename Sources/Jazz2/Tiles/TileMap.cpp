@@ -3,8 +3,12 @@
 #include "../LevelHandler.h"
 
 #include "../../nCine/Graphics/RenderQueue.h"
+#include "../../nCine/Graphics/RenderStatistics.h"
 #include "../../nCine/IO/IFileStream.h"
 #include "../../nCine/Base/Random.h"
+#include "../../nCine/Base/TimeStamp.h"
+#include "../../nCine/ServiceLocator.h"
+#include "../../nCine/tracy.h"
 
 namespace Jazz2::Tiles
 {
@@ -14,8 +18,12 @@ namespace Jazz2::Tiles
 		_sprLayerIndex(-1),
 		_hasPit(false),
 		_renderCommandsCount(0),
+		_chunkDrawFrame(0),
+		_debrisUpdateTime(0.0f),
 		_collapsingTimer(0.0f),
 		_triggerState(TriggerCount),
+		_checkpointGeneration(1),
+		_triggerStateForRollback(0),
 		_texturedBackgroundLayer(-1),
 		_texturedBackgroundPass(this)
 	{
@@ -126,8 +134,17 @@ namespace Jazz2::Tiles
 
 		_renderCommandsCount = 0;
 
-		for (auto& layer : _layers) {
-			DrawLayer(renderQueue, layer);
+		if (_tileChunks.size() != _layers.size()) {
+			InitializeTileChunks();
+		}
+		_chunkDrawFrame++;
+
+		if (_animatedTilesTexture != nullptr) {
+			UpdateAnimatedTilesTexture();
+		}
+
+		for (int32_t i = 0; i < (int32_t)_layers.size(); i++) {
+			DrawLayer(renderQueue, _layers[i], _tileChunks[i]);
 		}
 
 		DrawDebris(renderQueue);
@@ -344,6 +361,8 @@ namespace Jazz2::Tiles
 
 			tile.DestructFrameIndex += current;
 			tile.TileID = anim.Tiles[tile.DestructFrameIndex].TileID;
+			MarkSpriteTileDirty(tx + ty * _layers[_sprLayerIndex].LayoutSize.X);
+			InvalidateTileChunk(_sprLayerIndex, tx, ty);
 			if (tile.DestructFrameIndex >= max) {
 				if (!soundName.empty()) {
 					_levelHandler->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
@@ -376,6 +395,7 @@ namespace Jazz2::Tiles
 		for (int i = 0; i < _activeCollapsingTiles.size(); i++) {
 			Vector2i tilePos = _activeCollapsingTiles[i];
 			auto& tile = _layers[_sprLayerIndex].Layout[tilePos.X + tilePos.Y * layoutSize.X];
+			MarkSpriteTileDirty(tilePos.X + tilePos.Y * layoutSize.X);
 			if (tile.ExtraParam == 0) {
 				int amount = 1;
 				if (!AdvanceDestructibleTileAnimation(tile, tilePos.X, tilePos.Y, amount, "SceneryCollapse"_s)) {
@@ -391,7 +411,7 @@ namespace Jazz2::Tiles
 		}
 	}
 
-	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer)
+	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, TileChunkLayer& chunks)
 	{
 		if (!layer.Visible) {
 			return;
@@ -423,126 +443,482 @@ namespace Jazz2::Tiles
 			float remX = fmod(xt, (float)TileSet::DefaultTileSize);
 			float remY = fmod(yt, (float)TileSet::DefaultTileSize);
 
-			// Calculate the index (on the layer map) of the first tile that needs to be drawn to the position determined earlier
-			int tileX, tileY, tileAbsX, tileAbsY;
+			// Calculate the absolute index of the tile that precedes the position determined earlier
+			int tileAbsX = (int)(xt > 0 ? std::floor(xt / (float)TileSet::DefaultTileSize) : std::ceil(xt / (float)TileSet::DefaultTileSize));
+			int tileAbsY = (int)(yt > 0 ? std::floor(yt / (float)TileSet::DefaultTileSize) : std::ceil(yt / (float)TileSet::DefaultTileSize));
 
-			// Get the actual tile coords on the layer layout
-			if (xt > 0) {
-				tileAbsX = (int)std::floor(xt / (float)TileSet::DefaultTileSize);
-				tileX = tileAbsX % tileCount.X;
-			} else {
-				tileAbsX = (int)std::ceil(xt / (float)TileSet::DefaultTileSize);
-				tileX = tileAbsX % tileCount.X;
-				while (tileX < 0) {
-					tileX += tileCount.X;
+			// update x1 and y1 with the remainder so that we start at the tile boundary
+			// minus 1 because the first tile to draw is the one after the calculated index
+			x1 -= remX - (float)TileSet::DefaultTileSize;
+			y1 -= remY - (float)TileSet::DefaultTileSize;
+
+			// Calculate the last coordinates we want to draw to
+			float x3 = x1 + 100 + viewSize.X;
+			float y3 = y1 + 100 + viewSize.Y;
+
+			// Absolute index of the first tile is drawn at (x1, y1), following tiles are drawn on the grid
+			int32_t firstTileX = tileAbsX + 1;
+			int32_t firstTileY = tileAbsY + 1;
+			int32_t beginX = firstTileX;
+			int32_t beginY = firstTileY;
+			int32_t endX = firstTileX + (int32_t)std::ceil((x3 - x1) / TileSet::DefaultTileSize);
+			int32_t endY = firstTileY + (int32_t)std::ceil((y3 - y1) / TileSet::DefaultTileSize);
+			if (!layer.Description.RepeatX) {
+				// Draw only the first iteration of the layer horizontally
+				beginX = std::max(beginX, 0);
+				endX = std::min(endX, tileCount.X);
+			}
+			if (!layer.Description.RepeatY) {
+				// Draw only the first iteration of the layer vertically
+				beginY = std::max(beginY, 0);
+				endY = std::min(endY, tileCount.Y);
+			}
+
+			Vector2i texSize = _tileSet->TextureDiffuse->size();
+			Vector2f texBias;
+			if ((viewSize.X & 1) == 1) {
+				texBias.X = 0.5f / float(texSize.X);
+			}
+			if ((viewSize.Y & 1) == 1) {
+				texBias.Y = -0.5f / float(texSize.Y);
+			}
+
+			if (chunks.TileIndicesCommand != nullptr) {
+				if (endX > beginX && endY > beginY) {
+					DrawLayerOnGpu(renderQueue, layer, chunks, std::floor(x1 + (beginX - firstTileX) * TileSet::DefaultTileSize),
+						std::floor(y1 + (beginY - firstTileY) * TileSet::DefaultTileSize), Vector2i(beginX, beginY), Vector2i(endX - beginX, endY - beginY), texBias);
 				}
+				return;
 			}
 
-			if (yt > 0) {
-				tileAbsY = (int)std::floor(yt / (float)TileSet::DefaultTileSize);
-				tileY = tileAbsY % tileCount.Y;
+			// Walk through visible chunks, the last chunk of repeating layer can be smaller if the size is not aligned
+			int32_t ax = beginX;
+			while (ax < endX) {
+				int32_t tx = ax % tileCount.X;
+				if (tx < 0) {
+					tx += tileCount.X;
+				}
+				int32_t cx = tx / ChunkSize;
+				int32_t chunkAx = ax - (tx - cx * ChunkSize);
+				float chunkX = std::floor(x1 + (chunkAx - firstTileX) * TileSet::DefaultTileSize);
+
+				int32_t ay = beginY;
+				while (ay < endY) {
+					int32_t ty = ay % tileCount.Y;
+					if (ty < 0) {
+						ty += tileCount.Y;
+					}
+					int32_t cy = ty / ChunkSize;
+					int32_t chunkAy = ay - (ty - cy * ChunkSize);
+					float chunkY = std::floor(y1 + (chunkAy - firstTileY) * TileSet::DefaultTileSize);
+
+					TileChunk& chunk = chunks.Chunks[cx + cy * chunks.ChunkCount.X];
+					DrawTileChunk(renderQueue, layer, chunk, cx, cy, chunkX, chunkY, texBias);
+
+					ay = chunkAy + std::min(ChunkSize, tileCount.Y - cy * ChunkSize);
+				}
+
+				ax = chunkAx + std::min(ChunkSize, tileCount.X - cx * ChunkSize);
+			}
+		}
+	}
+
+	void TileMap::DrawTile(RenderQueue& renderQueue, TileMapLayer& layer, const LayerTile& tile, float x, float y, Vector2i viewSize)
+	{
+		int tileId;
+		if ((tile.Flags & LayerTileFlags::Animated) == LayerTileFlags::Animated) {
+			if (tile.TileID < _animatedTiles.size()) {
+				tileId = _animatedTiles[tile.TileID].Tiles[_animatedTiles[tile.TileID].CurrentTileIdx].TileID;
 			} else {
-				tileAbsY = (int)std::ceil(yt / (float)TileSet::DefaultTileSize);
-				tileY = tileAbsY % tileCount.Y;
-				while (tileY < 0) {
-					tileY += tileCount.Y;
+				return;
+			}
+		} else {
+			tileId = tile.TileID;
+		}
+
+		// Tile #0 is always empty
+		if (tileId == 0 || tile.Alpha == 0) {
+			return;
+		}
+
+		auto command = RentRenderCommand();
+		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		Vector2i texSize = _tileSet->TextureDiffuse->size();
+		float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
+		float texBiasX = (tileId % _tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.X);
+		float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
+		float texBiasY = (tileId / _tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.Y);
+
+		// ToDo: Flip normal map somehow
+		if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+			texBiasX += texScaleX;
+			texScaleX *= -1;
+		}
+		if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+			texBiasY += texScaleY;
+			texScaleY *= -1;
+		}
+
+		if ((viewSize.X & 1) == 1) {
+			texBiasX += 0.5f / float(texSize.X);
+		}
+		if ((viewSize.Y & 1) == 1) {
+			texBiasY -= 0.5f / float(texSize.Y);
+		}
+
+		command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+		command->material().spriteSizeUniform()->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+		command->material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, tile.Alpha / 255.0f).Data());
+
+		command->setTransformation(Matrix4x4f::Translation(std::floor(x + (TileSet::DefaultTileSize / 2)), std::floor(y + (TileSet::DefaultTileSize / 2)), 0.0f));
+		command->setLayer(layer.Description.Depth);
+		command->material().setTexture(*_tileSet->TextureDiffuse);
+
+		renderQueue.addCommand(command);
+	}
+
+	void TileMap::DrawTileChunk(RenderQueue& renderQueue, TileMapLayer& layer, TileChunk& chunk, int32_t cx, int32_t cy, float x, float y, Vector2f texBias)
+	{
+		if (!chunk.IsDirty) {
+			// Animated tiles are baked into the geometry, so the chunk has to be rebuilt when any of them advances
+			for (const Vector2i& animTile : chunk.AnimatedTiles) {
+				if (_animatedTiles[animTile.X].CurrentTileIdx != animTile.Y) {
+					chunk.IsDirty = true;
+					break;
 				}
 			}
+		}
+		if (chunk.IsDirty) {
+			RebuildTileChunk(layer, chunk, cx, cy);
+		}
 
-			// update x1 and y1 with the remainder so that we start at the tile boundary
-			// minus 1 because indices are updated in the beginning of the loops
-			x1 -= remX - (float)TileSet::DefaultTileSize;
-			y1 -= remY - (float)TileSet::DefaultTileSize;
+		if (chunk.VertexCount > 0) {
+			if (chunk.LastDrawFrame != _chunkDrawFrame) {
+				chunk.LastDrawFrame = _chunkDrawFrame;
+				chunk.UsedCommands = 0;
+			}
 
-			// Save the tile Y at the left border so that we can roll back to it at the start of every row iteration
-			int tileYs = tileY;
+			auto command = RentTileChunkCommand(layer, chunk);
+			command->material().texRectUniform()->setFloatValue(1.0f, texBias.X, 1.0f, texBias.Y);
 
-			// Calculate the last coordinates we want to draw to
-			float x3 = x1 + 100 + viewSize.X;
-			float y3 = y1 + 100 + viewSize.Y;
+			command->setTransformation(Matrix4x4f::Translation(x, y, 0.0f));
+			renderQueue.addCommand(command);
+
+			RenderStatistics::addCachedCommand(chunk.TileCount);
+		}
+
+		if (!chunk.TranslucentTiles.empty()) {
+			Vector2i viewSize = _levelHandler->GetViewSize();
+			for (int32_t tileIdx : chunk.TranslucentTiles) {
+				int32_t tx = (tileIdx % layer.LayoutSize.X) - cx * ChunkSize;
+				int32_t ty = (tileIdx / layer.LayoutSize.X) - cy * ChunkSize;
+				DrawTile(renderQueue, layer, layer.Layout[tileIdx], x + tx * TileSet::DefaultTileSize, y + ty * TileSet::DefaultTileSize, viewSize);
+			}
+		}
+	}
+
+	void TileMap::RebuildTileChunk(TileMapLayer& layer, TileChunk& chunk, int32_t cx, int32_t cy)
+	{
+		chunk.IsDirty = false;
+		chunk.AnimatedTiles.clear();
+		chunk.TranslucentTiles.clear();
+		chunk.TileCount = 0;
+
+		int32_t x1 = cx * ChunkSize;
+		int32_t y1 = cy * ChunkSize;
+		int32_t x2 = std::min(x1 + ChunkSize, layer.LayoutSize.X);
+		int32_t y2 = std::min(y1 + ChunkSize, layer.LayoutSize.Y);
+
+		// Every tile is a quad in one triangle strip, quads are connected with two degenerate vertices
+		int32_t maxFloats = ((x2 - x1) * (y2 - y1) * 6) * ChunkVertexFloats;
+		if ((int32_t)chunk.Vertices.size() < maxFloats) {
+			chunk.Vertices.resize(maxFloats);
+			// Custom VBO has to be recreated with the new size
+			for (auto& command : chunk.Commands) {
+				command->geometry().createCustomVbo(maxFloats, GL_STATIC_DRAW);
+			}
+		}
+
+		Vector2i texSize = _tileSet->TextureDiffuse->size();
+		float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
+		float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
+
+		float* vertices = chunk.Vertices.data();
+		int32_t vertexCount = 0;
+
+		for (int32_t ty = y1; ty < y2; ty++) {
+			for (int32_t tx = x1; tx < x2; tx++) {
+				int32_t tileIdx = tx + ty * layer.LayoutSize.X;
+				const LayerTile& tile = layer.Layout[tileIdx];
 
-			int tile_xo = -1;
-			for (float x2 = x1; x2 < x3; x2 += TileSet::DefaultTileSize) {
-				tileX = (tileX + 1) % tileCount.X;
-				tile_xo++;
-				if (!layer.Description.RepeatX) {
-					// If the current tile isn't in the first iteration of the layer horizontally, don't draw this column
-					if (tileAbsX + tile_xo + 1 < 0 || tileAbsX + tile_xo + 1 >= tileCount.X) {
+				int tileId;
+				if ((tile.Flags & LayerTileFlags::Animated) == LayerTileFlags::Animated) {
+					if (tile.TileID < 0 || (std::size_t)tile.TileID >= _animatedTiles.size()) {
 						continue;
 					}
-				}
-				tileY = tileYs;
-				int tile_yo = -1;
-				for (float y2 = y1; y2 < y3; y2 += TileSet::DefaultTileSize) {
-					tileY = (tileY + 1) % tileCount.Y;
-					tile_yo++;
-
-					LayerTile tile = layer.Layout[tileX + tileY * layer.LayoutSize.X];
-
-					if (!layer.Description.RepeatY) {
-						// If the current tile isn't in the first iteration of the layer vertically, don't draw it
-						if (tileAbsY + tile_yo + 1 < 0 || tileAbsY + tile_yo + 1 >= tileCount.Y) {
-							continue;
-						}
-					}
 
-					int tileId;
-					if ((tile.Flags & LayerTileFlags::Animated) == LayerTileFlags::Animated) {
-						if (tile.TileID < _animatedTiles.size()) {
-							tileId = _animatedTiles[tile.TileID].Tiles[_animatedTiles[tile.TileID].CurrentTileIdx].TileID;
-						} else {
-							continue;
-						}
-					} else {
-						tileId = tile.TileID;
-					}
+					const AnimatedTile& animTile = _animatedTiles[tile.TileID];
+					tileId = animTile.Tiles[animTile.CurrentTileIdx].TileID;
 
-					// Tile #0 is always empty
-					if (tileId == 0 || tile.Alpha == 0) {
-						continue;
+					Vector2i animState = Vector2i(tile.TileID, animTile.CurrentTileIdx);
+					if (std::find(chunk.AnimatedTiles.begin(), chunk.AnimatedTiles.end(), animState) == chunk.AnimatedTiles.end()) {
+						chunk.AnimatedTiles.push_back(animState);
 					}
+				} else {
+					tileId = tile.TileID;
+				}
 
-					auto command = RentRenderCommand();
-					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				// Tile #0 is always empty
+				if (tileId == 0 || tile.Alpha == 0) {
+					continue;
+				}
+				if (tile.Alpha != 255) {
+					chunk.TranslucentTiles.push_back(tileIdx);
+					continue;
+				}
 
-					Vector2i texSize = _tileSet->TextureDiffuse->size();
-					float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
-					float texBiasX = (tileId % _tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.X);
-					float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
-					float texBiasY = (tileId / _tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.Y);
+				float u1 = (tileId % _tileSet->TilesPerRow) * texScaleX;
+				float v1 = (tileId / _tileSet->TilesPerRow) * texScaleY;
+				float u2 = u1 + texScaleX;
+				float v2 = v1 + texScaleY;
 
-					// ToDo: Flip normal map somehow
-					if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
-						texBiasX += texScaleX;
-						texScaleX *= -1;
-					}
-					if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
-						texBiasY += texScaleY;
-						texScaleY *= -1;
-					}
+				// ToDo: Flip normal map somehow
+				if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+					std::swap(u1, u2);
+				}
+				if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+					std::swap(v1, v2);
+				}
 
-					if ((viewSize.X & 1) == 1) {
-						texBiasX += 0.5f / float(texSize.X);
-					}
-					if ((viewSize.Y & 1) == 1) {
-						texBiasY -= 0.5f / float(texSize.Y);
-					}
+				float px1 = (float)((tx - x1) * TileSet::DefaultTileSize);
+				float py1 = (float)((ty - y1) * TileSet::DefaultTileSize);
+				float px2 = px1 + TileSet::DefaultTileSize;
+				float py2 = py1 + TileSet::DefaultTileSize;
+
+				const float quad[4 * ChunkVertexFloats] = {
+					px1, py1, u1, v1,
+					px1, py2, u1, v2,
+					px2, py1, u2, v1,
+					px2, py2, u2, v2
+				};
+
+				if (vertexCount > 0) {
+					// Degenerate vertices to connect with the previous quad
+					std::memcpy(vertices, vertices - ChunkVertexFloats, ChunkVertexFloats * sizeof(float));
+					std::memcpy(vertices + ChunkVertexFloats, quad, ChunkVertexFloats * sizeof(float));
+					vertices += 2 * ChunkVertexFloats;
+					vertexCount += 2;
+				}
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, tile.Alpha / 255.0f).Data());
+				std::memcpy(vertices, quad, sizeof(quad));
+				vertices += 4 * ChunkVertexFloats;
+				vertexCount += 4;
+				chunk.TileCount++;
+			}
+		}
 
-					command->setTransformation(Matrix4x4f::Translation(std::floor(x2 + (TileSet::DefaultTileSize / 2)), std::floor(y2 + (TileSet::DefaultTileSize / 2)), 0.0f));
-					command->setLayer(layer.Description.Depth);
-					command->material().setTexture(*_tileSet->TextureDiffuse);
+		chunk.VertexCount = vertexCount;
+		for (auto& command : chunk.Commands) {
+			command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, vertexCount);
+			command->geometry().setHostVertexPointer(chunk.Vertices.data());
+		}
+
+		RenderStatistics::addCachedGeometryRebuild();
+	}
+
+	RenderCommand* TileMap::RentTileChunkCommand(TileMapLayer& layer, TileChunk& chunk)
+	{
+		if (chunk.UsedCommands < chunk.Commands.size()) {
+			RenderCommand* command = chunk.Commands[chunk.UsedCommands].get();
+			chunk.UsedCommands++;
+			return command;
+		}
+
+		std::unique_ptr<RenderCommand>& command = chunk.Commands.emplace_back(std::make_unique<RenderCommand>(RenderCommand::CommandTypes::MeshSprite));
+		command->material().setShaderProgramType(Material::ShaderProgramType::MESH_SPRITE);
+		command->material().setBlendingEnabled(true);
+		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		command->material().reserveUniformsDataMemory();
+		command->material().setTexture(*_tileSet->TextureDiffuse);
+		command->setLayer(layer.Description.Depth);
+
+		GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+		if (textureUniform && textureUniform->intValue(0) != 0) {
+			textureUniform->setIntValue(0); // GL_TEXTURE0
+		}
+
+		// Vertices contain final positions and texture coordinates
+		command->material().spriteSizeUniform()->setFloatValue(1.0f, 1.0f);
+		command->material().colorUniform()->setFloatVector(Colorf::White.Data());
+
+		command->geometry().setNumElementsPerVertex(ChunkVertexFloats);
+		command->geometry().createCustomVbo((uint32_t)chunk.Vertices.size(), GL_STATIC_DRAW);
+		command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, chunk.VertexCount);
+		command->geometry().setHostVertexPointer(chunk.Vertices.data());
+
+		chunk.UsedCommands++;
+		return command.get();
+	}
+
+	void TileMap::DrawLayerOnGpu(RenderQueue& renderQueue, TileMapLayer& layer, TileChunkLayer& chunks, float x, float y, Vector2i firstTile, Vector2i tileCount, Vector2f texBias)
+	{
+		auto command = chunks.TileIndicesCommand.get();
+
+		// Texture coordinates of the quad are pixels on the layer, so the shader can find the tile under each fragment
+		Vector2i texSize = _tileSet->TextureDiffuse->size();
+		float width = (float)(tileCount.X * TileSet::DefaultTileSize);
+		float height = (float)(tileCount.Y * TileSet::DefaultTileSize);
+
+		command->material().texRectUniform()->setFloatValue(width, firstTile.X * TileSet::DefaultTileSize + texBias.X * texSize.X,
+			height, firstTile.Y * TileSet::DefaultTileSize + texBias.Y * texSize.Y);
+		command->material().spriteSizeUniform()->setFloatValue(width, height);
+
+		command->setTransformation(Matrix4x4f::Translation(x + width * 0.5f, y + height * 0.5f, 0.0f));
+		renderQueue.addCommand(command);
+
+		RenderStatistics::addCachedCommand(tileCount.X * tileCount.Y);
+	}
 
-					renderQueue.addCommand(command);
+	void TileMap::InitializeTileChunks()
+	{
+		_tileChunks.clear();
+		_tileChunks.resize(_layers.size());
+
+		for (int32_t i = 0; i < (int32_t)_layers.size(); i++) {
+			TileChunkLayer& chunks = _tileChunks[i];
+			chunks.ChunkCount = Vector2i((_layers[i].LayoutSize.X + ChunkSize - 1) / ChunkSize, (_layers[i].LayoutSize.Y + ChunkSize - 1) / ChunkSize);
+			chunks.Chunks.resize(chunks.ChunkCount.X * chunks.ChunkCount.Y);
+			for (TileChunk& chunk : chunks.Chunks) {
+				chunk.IsDirty = true;
+			}
+
+			const LayerDescription& desc = _layers[i].Description;
+			if (i != _sprLayerIndex && i != _texturedBackgroundLayer && (desc.RepeatX || desc.RepeatY || desc.SpeedX != 1.0f || desc.SpeedY != 1.0f)) {
+				InitializeTileIndices(_layers[i], chunks);
+			}
+		}
+	}
+
+	bool TileMap::InitializeTileIndices(TileMapLayer& layer, TileChunkLayer& chunks)
+	{
+		Shader* shader = ContentResolver::Current().GetShader(PrecompiledShader::TileLayer);
+		if (shader == nullptr || !shader->isLinked()) {
+			return false;
+		}
+
+		int32_t maxTextureSize = theServiceLocator().gfxCapabilities().value(IGfxCapabilities::GLIntValues::MAX_TEXTURE_SIZE);
+		if (layer.LayoutSize.X > maxTextureSize || layer.LayoutSize.Y > maxTextureSize || (int32_t)_animatedTiles.size() > maxTextureSize) {
+			return false;
+		}
+
+		if (_animatedTilesTexture == nullptr) {
+			// Current frame of each animated tile is stored in one row, it's updated before drawing
+			_animatedTilesTexels.resize(std::max((int32_t)_animatedTiles.size(), 1) * 4);
+			_animatedTilesTexture = std::make_unique<Texture>("AnimatedTiles", Texture::Format::RGBA8, (int32_t)_animatedTilesTexels.size() / 4, 1);
+			_animatedTilesTexture->setMinFiltering(SamplerFilter::Nearest);
+			_animatedTilesTexture->setMagFiltering(SamplerFilter::Nearest);
+			UpdateAnimatedTilesTexture();
+			_animatedTilesTexture->loadFromTexels(_animatedTilesTexels.data());
+		}
+
+		// Tile index is packed in RG, flags in B and alpha in A
+		int32_t tileCount = layer.LayoutSize.X * layer.LayoutSize.Y;
+		std::unique_ptr<uint8_t[]> texels = std::make_unique<uint8_t[]>(tileCount * 4);
+		for (int32_t i = 0; i < tileCount; i++) {
+			const LayerTile& tile = layer.Layout[i];
+			int32_t tileId = tile.TileID;
+			uint8_t flags = 0;
+			if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+				flags |= 0x01;
+			}
+			if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+				flags |= 0x02;
+			}
+			if ((tile.Flags & LayerTileFlags::Animated) == LayerTileFlags::Animated) {
+				if (tileId < (int32_t)_animatedTiles.size()) {
+					flags |= 0x04;
+				} else {
+					tileId = 0;
 				}
 			}
+
+			texels[i * 4] = (uint8_t)(tileId & 0xff);
+			texels[i * 4 + 1] = (uint8_t)((tileId >> 8) & 0xff);
+			texels[i * 4 + 2] = flags;
+			texels[i * 4 + 3] = tile.Alpha;
+		}
+
+		chunks.TileIndices = std::make_unique<Texture>("TileIndices", Texture::Format::RGBA8, layer.LayoutSize);
+		chunks.TileIndices->loadFromTexels(texels.get());
+		chunks.TileIndices->setMinFiltering(SamplerFilter::Nearest);
+		chunks.TileIndices->setMagFiltering(SamplerFilter::Nearest);
+
+		chunks.TileIndicesCommand = std::make_unique<RenderCommand>();
+		RenderCommand* command = chunks.TileIndicesCommand.get();
+		command->material().setShader(shader);
+		command->material().setBlendingEnabled(true);
+		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		command->material().reserveUniformsDataMemory();
+		command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+
+		GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+		if (textureUniform && textureUniform->intValue(0) != 0) {
+			textureUniform->setIntValue(0); // GL_TEXTURE0
+		}
+		GLUniformCache* tileIndicesUniform = command->material().uniform("uTileIndices");
+		if (tileIndicesUniform && tileIndicesUniform->intValue(0) != 1) {
+			tileIndicesUniform->setIntValue(1); // GL_TEXTURE1
+		}
+		GLUniformCache* animatedTilesUniform = command->material().uniform("uAnimatedTiles");
+		if (animatedTilesUniform && animatedTilesUniform->intValue(0) != 2) {
+			animatedTilesUniform->setIntValue(2); // GL_TEXTURE2
+		}
+
+		command->material().uniform("uLayerSize")->setFloatValue(layer.LayoutSize.X, layer.LayoutSize.Y);
+		command->material().uniform("uRepeat")->setFloatValue(layer.Description.RepeatX ? 1.0f : 0.0f, layer.Description.RepeatY ? 1.0f : 0.0f);
+		command->material().uniform("uTilesPerRow")->setFloatValue(_tileSet->TilesPerRow);
+
+		command->material().colorUniform()->setFloatVector(Colorf::White.Data());
+
+		command->setLayer(layer.Description.Depth);
+		command->material().setTexture(0, *_tileSet->TextureDiffuse);
+		command->material().setTexture(1, *chunks.TileIndices);
+		command->material().setTexture(2, *_animatedTilesTexture);
+		return true;
+	}
+
+	void TileMap::UpdateAnimatedTilesTexture()
+	{
+		bool hasChanged = false;
+		for (int32_t i = 0; i < (int32_t)_animatedTiles.size(); i++) {
+			const AnimatedTile& animTile = _animatedTiles[i];
+			int32_t tileId = animTile.Tiles[animTile.CurrentTileIdx].TileID;
+			uint8_t low = (uint8_t)(tileId & 0xff);
+			uint8_t high = (uint8_t)((tileId >> 8) & 0xff);
+			if (_animatedTilesTexels[i * 4] != low || _animatedTilesTexels[i * 4 + 1] != high) {
+				_animatedTilesTexels[i * 4] = low;
+				_animatedTilesTexels[i * 4 + 1] = high;
+				hasChanged = true;
+			}
+		}
+
+		if (hasChanged) {
+			_animatedTilesTexture->loadFromTexels(_animatedTilesTexels.data());
 		}
 	}
 
+	void TileMap::InvalidateTileChunk(int32_t layerIndex, int32_t tx, int32_t ty)
+	{
+		// Chunks are created on the first draw
+		if (layerIndex < 0 || layerIndex >= (int32_t)_tileChunks.size()) {
+			return;
+		}
+
+		TileChunkLayer& chunks = _tileChunks[layerIndex];
+		chunks.Chunks[(tx / ChunkSize) + (ty / ChunkSize) * chunks.ChunkCount.X].IsDirty = true;
+	}
+
 	float TileMap::TranslateCoordinate(float coordinate, float speed, float offset, bool isY, int viewHeight, int viewWidth)
 	{
 		// Coordinate: the "vanilla" coordinate of the tile on the layer if the layer was fixed to the sprite layer with same
@@ -717,6 +1093,8 @@ namespace Jazz2::Tiles
 				SetTileDestructibleEventParams(tile, TileDestructType::Collapse, tileParams[0]);
 				break;
 		}
+
+		InvalidateTileChunk(_sprLayerIndex, x, y);
 	}
 
 	void TileMap::SetTileDestructibleEventParams(LayerTile& tile, TileDestructType type, uint8_t extraParam)
@@ -756,7 +1134,7 @@ namespace Jazz2::Tiles
 			}
 		}
 
-		_debrisList.push_back(debris);
+		_debrisList.Add(debris);
 	}
 
 	void TileMap::CreateTileDebris(int tileId, int x, int y)
@@ -788,7 +1166,7 @@ namespace Jazz2::Tiles
 		}*/
 
 		for (int i = 0; i < 4; i++) {
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris;
 			debris.Pos = Vector2f(x * TileSet::DefaultTileSize + (i % 2) * QuarterSize, y * TileSet::DefaultTileSize + (i / 2) * QuarterSize);
 			debris.Depth = z;
 			debris.Size = Vector2f(QuarterSize, QuarterSize);
@@ -812,6 +1190,7 @@ namespace Jazz2::Tiles
 
 			debris.DiffuseTexture = _tileSet->TextureDiffuse.get();
 			debris.Flags = DebrisFlags::None;
+			_debrisList.Add(debris);
 		}
 	}
 
@@ -827,7 +1206,7 @@ namespace Jazz2::Tiles
 			for (int fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
 				float currentSize = DebrisSize * Random().FastFloat(0.2f, 1.1f);
 
-				DestructibleDebris& debris = _debrisList.emplace_back();
+				DestructibleDebris debris;
 				debris.Pos = Vector2f(x + (isFacingLeft ? res->Base->FrameDimensions.X - fx : fx), y + fy);
 				debris.Depth = (uint16_t)pos.Z;
 				debris.Size = Vector2f(currentSize, currentSize);
@@ -852,6 +1231,7 @@ namespace Jazz2::Tiles
 
 				debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 				debris.Flags = DebrisFlags::Bounce;
+				_debrisList.Add(debris);
 			}
 		}
 	}
@@ -865,7 +1245,7 @@ namespace Jazz2::Tiles
 		for (int i = 0; i < count; i++) {
 			float speedX = Random().FastFloat(-1.0f, 1.0f) * Random().FastFloat(0.2f, 0.8f) * count;
 
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris;
 			debris.Pos = Vector2f(x, y);
 			debris.Depth = (uint16_t)pos.Z;
 			debris.Size = Vector2f((float)res->Base->FrameDimensions.X, (float)res->Base->FrameDimensions.Y);
@@ -892,107 +1272,268 @@ namespace Jazz2::Tiles
 
 			debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 			debris.Flags = DebrisFlags::Bounce;
+			_debrisList.Add(debris);
 		}
 	}
 
 	void TileMap::UpdateDebris(float timeMult)
 	{
-		for (int i = (int)_debrisList.size() - 1; i >= 0; i--) {
-			DestructibleDebris& debris = _debrisList[i];
+		ZoneScoped;
+
+		TimeStamp start = TimeStamp::now();
+
+		int count = (int)_debrisList.Flags.size();
+		float halfTimeMult2 = 0.5f * timeMult * timeMult;
+
+		float* posX = _debrisList.PosX.data();
+		float* posY = _debrisList.PosY.data();
+		float* speedX = _debrisList.SpeedX.data();
+		float* speedY = _debrisList.SpeedY.data();
+		float* accelX = _debrisList.AccelerationX.data();
+		float* accelY = _debrisList.AccelerationY.data();
+		float* scale = _debrisList.Scale.data();
+		float* scaleSpeed = _debrisList.ScaleSpeed.data();
+		float* angle = _debrisList.Angle.data();
+		float* angleSpeed = _debrisList.AngleSpeed.data();
+		float* alpha = _debrisList.Alpha.data();
+		float* alphaSpeed = _debrisList.AlphaSpeed.data();
+		float* time = _debrisList.Time.data();
+		DebrisFlags* flags = _debrisList.Flags.data();
+
+		// Fade out expired debris, branch-free so the compiler can vectorize it
+		for (int i = 0; i < count; i++) {
+			time[i] -= timeMult;
+			alphaSpeed[i] = (time[i] <= 0.0f ? -std::min(0.02f, alpha[i]) : alphaSpeed[i]);
+		}
 
-			debris.Time -= timeMult;
-			if (debris.Scale <= 0.0f || debris.Alpha <= 0.0f) {
-				_debrisList.erase(_debrisList.begin() + i);
+		// Only debris with Disappear or Bounce flag collides with the tilemap
+		for (int i = 0; i < count; i++) {
+			if ((flags[i] & (DebrisFlags::Disappear | DebrisFlags::Bounce)) == DebrisFlags::None) {
 				continue;
 			}
-			if (debris.Time <= 0.0f) {
-				debris.AlphaSpeed = -std::min(0.02f, debris.Alpha);
-			}
 
-			if ((debris.Flags & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
-				// Debris should collide with tilemap
-				float nx = debris.Pos.X + debris.Speed.X * timeMult;
-				float ny = debris.Pos.Y + debris.Speed.Y * timeMult;
-				AABB aabb = AABBf(nx - 1, ny - 1, nx + 1, ny + 1);
-				TileCollisionParams params = { TileDestructType::None, true };
-				if (IsTileEmpty(aabb, params)) {
-					// Nothing...
-				} else if ((debris.Flags & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
-					debris.ScaleSpeed = -0.02f;
-					debris.AlphaSpeed = -0.006f;
-					debris.Speed = Vector2f::Zero;
-					debris.Acceleration = Vector2f::Zero;
-				} else {
-					// Place us to the ground only if no horizontal movement was
-					// involved (this prevents speeds resetting if the actor
-					// collides with a wall from the side while in the air)
-					aabb.T = debris.Pos.Y - 1;
-					aabb.B = debris.Pos.Y + 1;
-
-					if (IsTileEmpty(aabb, params)) {
-						if (debris.Speed.Y > 0.0f) {
-							debris.Speed.Y = -(0.8f/*elasticity*/ * debris.Speed.Y);
-							//OnHitFloorHook();
-						} else {
-							debris.Speed.Y = 0;
-							//OnHitCeilingHook();
-						}
+			float x = posX[i];
+			float y = posY[i];
+			float nx = x + speedX[i] * timeMult;
+			float ny = y + speedY[i] * timeMult;
+			if (IsDebrisAreaEmpty(nx - 1, ny - 1, nx + 1, ny + 1)) {
+				// Nothing...
+			} else if ((flags[i] & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
+				scaleSpeed[i] = -0.02f;
+				alphaSpeed[i] = -0.006f;
+				speedX[i] = 0.0f;
+				speedY[i] = 0.0f;
+				accelX[i] = 0.0f;
+				accelY[i] = 0.0f;
+			} else {
+				// Place us to the ground only if no horizontal movement was
+				// involved (this prevents speeds resetting if the actor
+				// collides with a wall from the side while in the air)
+				if (IsDebrisAreaEmpty(nx - 1, y - 1, nx + 1, y + 1)) {
+					if (speedY[i] > 0.0f) {
+						speedY[i] = -(0.8f/*elasticity*/ * speedY[i]);
+					} else {
+						speedY[i] = 0;
 					}
+				}
 
-					// If the actor didn't move all the way horizontally,
-					// it hit a wall (or was already touching it)
-					aabb = AABBf(debris.Pos.X - 1, ny - 1, debris.Pos.X + 1, ny + 1);
-					if (IsTileEmpty(aabb, params)) {
-						debris.Speed.X = -(0.8f/*elasticity*/ * debris.Speed.X);
-						debris.AngleSpeed = -(0.8f/*elasticity*/ * debris.AngleSpeed);
-						//OnHitWallHook();
-					}
+				// If the actor didn't move all the way horizontally,
+				// it hit a wall (or was already touching it)
+				if (IsDebrisAreaEmpty(x - 1, ny - 1, x + 1, ny + 1)) {
+					speedX[i] = -(0.8f/*elasticity*/ * speedX[i]);
+					angleSpeed[i] = -(0.8f/*elasticity*/ * angleSpeed[i]);
 				}
 			}
+		}
 
-			debris.Pos.X += debris.Speed.X * timeMult + 0.5f * debris.Acceleration.X * timeMult * timeMult;
-			debris.Pos.Y += debris.Speed.Y * timeMult + 0.5f * debris.Acceleration.Y * timeMult * timeMult;
+		// Integrate all debris, branch-free so the compiler can vectorize it
+		for (int i = 0; i < count; i++) {
+			posX[i] += speedX[i] * timeMult + accelX[i] * halfTimeMult2;
+			posY[i] += speedY[i] * timeMult + accelY[i] * halfTimeMult2;
+			speedX[i] = (accelX[i] != 0.0f ? std::min(speedX[i] + accelX[i] * timeMult, 10.0f) : speedX[i]);
+			speedY[i] = (accelY[i] != 0.0f ? std::min(speedY[i] + accelY[i] * timeMult, 10.0f) : speedY[i]);
+			scale[i] += scaleSpeed[i] * timeMult;
+			angle[i] += angleSpeed[i] * timeMult;
+			alpha[i] += alphaSpeed[i] * timeMult;
+		}
 
-			if (debris.Acceleration.X != 0.0f) {
-				debris.Speed.X = std::min(debris.Speed.X + debris.Acceleration.X * timeMult, 10.0f);
-			}
-			if (debris.Acceleration.Y != 0.0f) {
-				debris.Speed.Y = std::min(debris.Speed.Y + debris.Acceleration.Y * timeMult, 10.0f);
+		// Remove invisible debris, order of the remaining debris is not preserved
+		for (int i = count - 1; i >= 0; i--) {
+			if (scale[i] <= 0.0f || alpha[i] <= 0.0f) {
+				_debrisList.RemoveAt(i);
 			}
-
-			debris.Scale += debris.ScaleSpeed * timeMult;
-			debris.Angle += debris.AngleSpeed * timeMult;
-			debris.Alpha += debris.AlphaSpeed * timeMult;
 		}
+
+		_debrisUpdateTime = start.millisecondsSince();
+		TracyPlot("Debris", static_cast<int64_t>(_debrisList.Flags.size()));
 	}
 
 	void TileMap::DrawDebris(RenderQueue& renderQueue)
 	{
-		for (auto& debris : _debrisList) {
+		int count = (int)_debrisList.Flags.size();
+		for (int i = 0; i < count; i++) {
+			auto& renderData = _debrisList.RenderData[i];
 			auto command = RentRenderCommand();
 
-			if ((debris.Flags & DebrisFlags::AdditivaBlending) == DebrisFlags::AdditivaBlending) {
+			if ((_debrisList.Flags[i] & DebrisFlags::AdditivaBlending) == DebrisFlags::AdditivaBlending) {
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
 			} else {
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 			}
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(debris.Size.X, debris.Size.Y);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			command->material().texRectUniform()->setFloatValue(renderData.TexScaleX, renderData.TexBiasX, renderData.TexScaleY, renderData.TexBiasY);
+			command->material().spriteSizeUniform()->setFloatValue(renderData.Size.X, renderData.Size.Y);
+			command->material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, _debrisList.Alpha[i]).Data());
 
-			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
-			worldMatrix.RotateZ(debris.Angle);
-			worldMatrix.Scale(debris.Scale, debris.Scale, 1.0f);
+			Matrix4x4f worldMatrix = Matrix4x4f::Translation(_debrisList.PosX[i], _debrisList.PosY[i], 0.0f);
+			worldMatrix.RotateZ(_debrisList.Angle[i]);
+			worldMatrix.Scale(_debrisList.Scale[i], _debrisList.Scale[i], 1.0f);
 			command->setTransformation(worldMatrix);
-			command->setLayer(debris.Depth);
-			command->material().setTexture(*debris.DiffuseTexture);
+			command->setLayer(renderData.Depth);
+			command->material().setTexture(*renderData.DiffuseTexture);
 
 			renderQueue.addCommand(command);
 		}
 	}
 
+	bool TileMap::IsDebrisAreaEmpty(float x1, float y1, float x2, float y2)
+	{
+		// Simplified version of IsTileEmpty() that only reads solidity data, debris never destroys tiles
+		if (_sprLayerIndex == -1) {
+			return false;
+		}
+
+		auto& spriteLayer = _layers[_sprLayerIndex];
+		int limitRightPx = spriteLayer.LayoutSize.X * TileSet::DefaultTileSize;
+		int limitBottomPx = spriteLayer.LayoutSize.Y * TileSet::DefaultTileSize;
+
+		// Consider out-of-level coordinates as solid walls
+		if (x1 < 0 || y1 < 0 || x2 >= limitRightPx) {
+			return false;
+		}
+		if (y2 >= limitBottomPx) {
+			return _hasPit;
+		}
+
+		int hx1 = (int)x1;
+		int hx2 = std::min((int)std::ceil(x2), limitRightPx - 1);
+		int hy1 = (int)y1;
+		int hy2 = std::min((int)std::ceil(y2), limitBottomPx - 1);
+
+		for (int y = hy1 / TileSet::DefaultTileSize; y <= hy2 / TileSet::DefaultTileSize; y++) {
+			for (int x = hx1 / TileSet::DefaultTileSize; x <= hx2 / TileSet::DefaultTileSize; x++) {
+				LayerTile& tile = spriteLayer.Layout[y * spriteLayer.LayoutSize.X + x];
+				if (tile.HasSuspendType != SuspendType::None) {
+					continue;
+				}
+
+				int tileId = ResolveTileID(tile);
+				if (_tileSet->IsTileMaskEmpty(tileId)) {
+					continue;
+				}
+				if (_tileSet->IsTileMaskFilled(tileId)) {
+					return false;
+				}
+
+				int tx = x * TileSet::DefaultTileSize;
+				int ty = y * TileSet::DefaultTileSize;
+
+				int left = std::max(hx1 - tx, 0);
+				int right = std::min(hx2 - tx, TileSet::DefaultTileSize - 1);
+				int top = std::max(hy1 - ty, 0);
+				int bottom = std::min(hy2 - ty, TileSet::DefaultTileSize - 1);
+
+				if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+					int left2 = left;
+					left = (TileSet::DefaultTileSize - 1 - right);
+					right = (TileSet::DefaultTileSize - 1 - left2);
+				}
+				if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+					int top2 = top;
+					top = (TileSet::DefaultTileSize - 1 - bottom);
+					bottom = (TileSet::DefaultTileSize - 1 - top2);
+				}
+
+				uint8_t* mask = _tileSet->GetTileMask(tileId);
+				for (int ry = top; ry <= bottom; ry++) {
+					for (int rx = left; rx <= right; rx++) {
+						if (mask[ry * TileSet::DefaultTileSize + rx]) {
+							return false;
+						}
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void TileMap::DebrisList::Add(const DestructibleDebris& debris)
+	{
+		PosX.push_back(debris.Pos.X);
+		PosY.push_back(debris.Pos.Y);
+		SpeedX.push_back(debris.Speed.X);
+		SpeedY.push_back(debris.Speed.Y);
+		AccelerationX.push_back(debris.Acceleration.X);
+		AccelerationY.push_back(debris.Acceleration.Y);
+		Scale.push_back(debris.Scale);
+		ScaleSpeed.push_back(debris.ScaleSpeed);
+		Angle.push_back(debris.Angle);
+		AngleSpeed.push_back(debris.AngleSpeed);
+		Alpha.push_back(debris.Alpha);
+		AlphaSpeed.push_back(debris.AlphaSpeed);
+		Time.push_back(debris.Time);
+		Flags.push_back(debris.Flags);
+
+		DebrisRenderData& renderData = RenderData.emplace_back();
+		renderData.Size = debris.Size;
+		renderData.TexScaleX = debris.TexScaleX;
+		renderData.TexBiasX = debris.TexBiasX;
+		renderData.TexScaleY = debris.TexScaleY;
+		renderData.TexBiasY = debris.TexBiasY;
+		renderData.DiffuseTexture = debris.DiffuseTexture;
+		renderData.Depth = debris.Depth;
+	}
+
+	void TileMap::DebrisList::RemoveAt(int i)
+	{
+		// Swap with the last item instead of shifting the rest of arrays
+		int last = (int)Flags.size() - 1;
+		if (i != last) {
+			PosX[i] = PosX[last];
+			PosY[i] = PosY[last];
+			SpeedX[i] = SpeedX[last];
+			SpeedY[i] = SpeedY[last];
+			AccelerationX[i] = AccelerationX[last];
+			AccelerationY[i] = AccelerationY[last];
+			Scale[i] = Scale[last];
+			ScaleSpeed[i] = ScaleSpeed[last];
+			Angle[i] = Angle[last];
+			AngleSpeed[i] = AngleSpeed[last];
+			Alpha[i] = Alpha[last];
+			AlphaSpeed[i] = AlphaSpeed[last];
+			Time[i] = Time[last];
+			Flags[i] = Flags[last];
+			RenderData[i] = RenderData[last];
+		}
+
+		PosX.pop_back();
+		PosY.pop_back();
+		SpeedX.pop_back();
+		SpeedY.pop_back();
+		AccelerationX.pop_back();
+		AccelerationY.pop_back();
+		Scale.pop_back();
+		ScaleSpeed.pop_back();
+		Angle.pop_back();
+		AngleSpeed.pop_back();
+		Alpha.pop_back();
+		AlphaSpeed.pop_back();
+		Time.pop_back();
+		Flags.pop_back();
+		RenderData.pop_back();
+	}
+
 	bool TileMap::GetTrigger(uint8_t triggerId)
 	{
 		return _triggerState[triggerId];
@@ -1015,11 +1556,90 @@ namespace Jazz2::Tiles
 				if (_animatedTiles[tile.DestructAnimation].Tiles.size() > 1) {
 					tile.DestructFrameIndex = (newState ? 1 : 0);
 					tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[tile.DestructFrameIndex].TileID;
+					MarkSpriteTileDirty(i);
+					InvalidateTileChunk(_sprLayerIndex, i % layoutSize.X, i / layoutSize.X);
 				}
 			}
 		}
 	}
 
+	void TileMap::CreateCheckpointForRollback()
+	{
+		if (_sprLayerIndex == -1) {
+			return;
+		}
+
+		auto& spriteLayer = _layers[_sprLayerIndex];
+		int32_t tileCount = spriteLayer.LayoutSize.X * spriteLayer.LayoutSize.Y;
+
+		if (_sprLayoutForRollback == nullptr) {
+			// First checkpoint copies the whole layer, then only modified pages are copied
+			_sprLayoutForRollback = std::make_unique<LayerTile[]>(tileCount);
+			std::memcpy(_sprLayoutForRollback.get(), spriteLayer.Layout.get(), tileCount * sizeof(LayerTile));
+			_pageGenerations.resize((tileCount + CheckpointPageSize - 1) / CheckpointPageSize);
+		} else {
+			for (int32_t page : _dirtyPages) {
+				int32_t first = page * CheckpointPageSize;
+				int32_t count = std::min(CheckpointPageSize, tileCount - first);
+				std::memcpy(&_sprLayoutForRollback[first], &spriteLayer.Layout[first], count * sizeof(LayerTile));
+			}
+		}
+		_dirtyPages.clear();
+		_checkpointGeneration++;
+
+		_activeCollapsingTilesForRollback.clear();
+		_activeCollapsingTilesForRollback.append(_activeCollapsingTiles.begin(), _activeCollapsingTiles.end());
+
+		_triggerStateForRollback = 0;
+		for (int i = 0; i < TriggerCount; i++) {
+			if (_triggerState[i]) {
+				_triggerStateForRollback |= (1u << i);
+			}
+		}
+	}
+
+	void TileMap::RollbackToCheckpoint()
+	{
+		if (_sprLayoutForRollback == nullptr) {
+			return;
+		}
+
+		// Restore destroyed and collapsed tiles
+		auto& spriteLayer = _layers[_sprLayerIndex];
+		int32_t tileCount = spriteLayer.LayoutSize.X * spriteLayer.LayoutSize.Y;
+		for (int32_t page : _dirtyPages) {
+			int32_t first = page * CheckpointPageSize;
+			int32_t count = std::min(CheckpointPageSize, tileCount - first);
+			std::memcpy(&spriteLayer.Layout[first], &_sprLayoutForRollback[first], count * sizeof(LayerTile));
+			for (int32_t i = first; i < first + count; i++) {
+				InvalidateTileChunk(_sprLayerIndex, i % spriteLayer.LayoutSize.X, i / spriteLayer.LayoutSize.X);
+			}
+		}
+		_dirtyPages.clear();
+		_checkpointGeneration++;
+
+		_activeCollapsingTiles.clear();
+		_activeCollapsingTiles.append(_activeCollapsingTilesForRollback.begin(), _activeCollapsingTilesForRollback.end());
+
+		for (int i = 0; i < TriggerCount; i++) {
+			_triggerState.Set(i, (_triggerStateForRollback & (1u << i)) != 0);
+		}
+	}
+
+	void TileMap::MarkSpriteTileDirty(int32_t tileIdx)
+	{
+		// Nothing to track until the first checkpoint is created
+		if (_sprLayoutForRollback == nullptr) {
+			return;
+		}
+
+		int32_t page = tileIdx / CheckpointPageSize;
+		if (_pageGenerations[page] != _checkpointGeneration) {
+			_pageGenerations[page] = _checkpointGeneration;
+			_dirtyPages.push_back(page);
+		}
+	}
+
 	void TileMap::RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y)
 	{
 		auto target = _texturedBackgroundPass._target.get();
@@ -1032,10 +1652,9 @@ namespace Jazz2::Tiles
 
 		auto command = &_texturedBackgroundPass._outputRenderCommand;
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(viewSize.X, viewSize.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		command->material().texRectUniform()->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+		command->material().spriteSizeUniform()->setFloatValue(viewSize.X, viewSize.Y);
+		command->material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		command->material().uniform("uViewSize")->setFloatValue(viewSize.X, viewSize.Y);
 		command->material().uniform("uCameraPos")->setFloatVector(viewCenter.Data());
@@ -1158,10 +1777,9 @@ namespace Jazz2::Tiles
 					texBiasY -= 0.5f / float(texSize.Y);
 				}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->material().spriteSizeUniform()->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				command->material().colorUniform()->setFloatVector(Colorf::White.Data());
 
 				command->setTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), y * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), 0.0f));
 				command->material().setTexture(*_owner->_tileSet->TextureDiffuse);
@@ -148,12 +148,30 @@ namespace Jazz2::Tiles
 		void CreateParticleDebris(const GraphicResource* res, Vector3f pos, Vector2f force, int currentFrame, bool isFacingLeft);
 		void CreateSpriteDebris(const GraphicResource* res, Vector3f pos, int count);
 
+		int GetDebrisCount() const
+		{
+			return (int)_debrisList.Flags.size();
+		}
+
+		/// Returns time spent in the last debris update in milliseconds
+		float GetDebrisUpdateTime() const
+		{
+			return _debrisUpdateTime;
+		}
+
 		bool GetTrigger(uint8_t triggerId);
 		void SetTrigger(uint8_t triggerId, bool newState);
 
+		void CreateCheckpointForRollback();
+		void RollbackToCheckpoint();
+
 		void OnInitializeViewport();
 
 	private:
+		static constexpr int32_t CheckpointPageSize = 256;
+		static constexpr int32_t ChunkSize = 16;
+		static constexpr int32_t ChunkVertexFloats = 4;
+
 		class TexturedBackgroundPass : public SceneNode
 		{
 			friend class TileMap;
@@ -178,6 +196,61 @@ namespace Jazz2::Tiles
 			bool _alreadyRendered;
 		};
 
+		// Debris is stored as structure of arrays, so the integration loop touches only the hot data
+		struct DebrisRenderData {
+			Vector2f Size;
+			float TexScaleX;
+			float TexBiasX;
+			float TexScaleY;
+			float TexBiasY;
+			Texture* DiffuseTexture;
+			uint16_t Depth;
+		};
+
+		struct DebrisList {
+			SmallVector<float, 0> PosX;
+			SmallVector<float, 0> PosY;
+			SmallVector<float, 0> SpeedX;
+			SmallVector<float, 0> SpeedY;
+			SmallVector<float, 0> AccelerationX;
+			SmallVector<float, 0> AccelerationY;
+			SmallVector<float, 0> Scale;
+			SmallVector<float, 0> ScaleSpeed;
+			SmallVector<float, 0> Angle;
+			SmallVector<float, 0> AngleSpeed;
+			SmallVector<float, 0> Alpha;
+			SmallVector<float, 0> AlphaSpeed;
+			SmallVector<float, 0> Time;
+
+			SmallVector<DebrisFlags, 0> Flags;
+			SmallVector<DebrisRenderData, 0> RenderData;
+
+			void Add(const DestructibleDebris& debris);
+			void RemoveAt(int i);
+		};
+
+		// Geometry of ChunkSize×ChunkSize tiles is cached and drawn by one command, it's rebuilt only if any tile changes
+		struct TileChunk {
+			SmallVector<std::unique_ptr<RenderCommand>, 1> Commands;	// Repeating layers can draw the same chunk more than once
+			SmallVector<float, 0> Vertices;
+			SmallVector<Vector2i, 0> AnimatedTiles;		// Animated tile index and its frame baked into the geometry
+			SmallVector<int32_t, 0> TranslucentTiles;	// Tiles with alpha are drawn separately
+			int32_t VertexCount;
+			int32_t TileCount;
+			uint32_t LastDrawFrame;
+			uint32_t UsedCommands;
+			bool IsDirty;
+		};
+
+		struct TileChunkLayer {
+			SmallVector<TileChunk, 0> Chunks;
+			Vector2i ChunkCount;
+
+			// Repeating and parallax layers are resolved in the shader from the layout uploaded as tile index texture
+			std::unique_ptr<Texture> TileIndices;
+			std::unique_ptr<RenderCommand> TileIndicesCommand;
+		};
+
 		LevelHandler* _levelHandler;
 		int _sprLayerIndex;
 		bool _hasPit;
@@ -189,23 +262,47 @@ namespace Jazz2::Tiles
 		float _collapsingTimer;
 		BitArray _triggerState;
 
-		SmallVector<DestructibleDebris, 0> _debrisList;
+		// Copy of sprite layer for rollback, only pages modified since the last checkpoint are copied or restored
+		std::unique_ptr<LayerTile[]> _sprLayoutForRollback;
+		SmallVector<uint32_t, 0> _pageGenerations;
+		SmallVector<int32_t, 0> _dirtyPages;
+		uint32_t _checkpointGeneration;
+		SmallVector<Vector2i, 0> _activeCollapsingTilesForRollback;
+		uint32_t _triggerStateForRollback;
+
+		DebrisList _debrisList;
+		float _debrisUpdateTime;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		int _renderCommandsCount;
+		SmallVector<TileChunkLayer, 0> _tileChunks;
+		uint32_t _chunkDrawFrame;
+		std::unique_ptr<Texture> _animatedTilesTexture;
+		SmallVector<uint8_t, 0> _animatedTilesTexels;
 
 		int _texturedBackgroundLayer;
 		TexturedBackgroundPass _texturedBackgroundPass;
 
-		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer);
+		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, TileChunkLayer& chunks);
+		void DrawTile(RenderQueue& renderQueue, TileMapLayer& layer, const LayerTile& tile, float x, float y, Vector2i viewSize);
+		void DrawTileChunk(RenderQueue& renderQueue, TileMapLayer& layer, TileChunk& chunk, int32_t cx, int32_t cy, float x, float y, Vector2f texBias);
+		void RebuildTileChunk(TileMapLayer& layer, TileChunk& chunk, int32_t cx, int32_t cy);
+		RenderCommand* RentTileChunkCommand(TileMapLayer& layer, TileChunk& chunk);
+		void DrawLayerOnGpu(RenderQueue& renderQueue, TileMapLayer& layer, TileChunkLayer& chunks, float x, float y, Vector2i firstTile, Vector2i tileCount, Vector2f texBias);
+		void InitializeTileChunks();
+		bool InitializeTileIndices(TileMapLayer& layer, TileChunkLayer& chunks);
+		void UpdateAnimatedTilesTexture();
+		void InvalidateTileChunk(int32_t layerIndex, int32_t tx, int32_t ty);
 		static float TranslateCoordinate(float coordinate, float speed, float offset, bool isY, int viewHeight, int viewWidth);
 		RenderCommand* RentRenderCommand();
 
 		bool AdvanceDestructibleTileAnimation(LayerTile& tile, int tx, int ty, int& amount, const StringView& soundName);
 		void AdvanceCollapsingTileTimers(float timeMult);
 		void SetTileDestructibleEventParams(LayerTile& tile, TileDestructType type, uint8_t extraParam);
+		void MarkSpriteTileDirty(int32_t tileIdx);
 
 		void UpdateDebris(float timeMult);
 		void DrawDebris(RenderQueue& renderQueue);
+		bool IsDebrisAreaEmpty(float x1, float y1, float x2, float y2);
 
 		void RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y);
 
@@ -58,10 +58,9 @@ namespace Jazz2::UI
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(texCoords.Data());
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->material().texRectUniform()->setFloatVector(texCoords.Data());
+		command->material().spriteSizeUniform()->setFloatVector(size.Data());
+		command->material().colorUniform()->setFloatVector(color.Data());
 
 		command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f).RotateZ(angle));
 		command->setLayer(z);
@@ -86,9 +85,8 @@ namespace Jazz2::UI
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->material().spriteSizeUniform()->setFloatVector(size.Data());
+		command->material().colorUniform()->setFloatVector(color.Data());
 
 		command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
 		command->setLayer(z);
@@ -16,11 +16,19 @@ namespace Jazz2::UI
 	Cinematics::Cinematics(IRootController* root, const String& path, const std::function<bool(IRootController*, bool)>& callback)
 		:
 		_root(root),
+#if defined(WITH_THREADS)
+		_decoderQuit(false),
+		_decoderRunning(false),
+#endif
 		_callback(callback),
 		_frameDelay(0.0f),
 		_frameProgress(0.0f),
 		_framesLeft(0),
-		_currentOffsets { },
+		_alignedWidth(0),
+		_framesToDecode(0),
+		_frameReadIndex(0),
+		_frameWriteIndex(0),
+		_decodedFrameCount(0),
 		_pressedKeys((uint32_t)KeySym::COUNT),
 		_pressedActions(0)
 	{
@@ -36,6 +44,15 @@ namespace Jazz2::UI
 			return;
 		}
 
+#if defined(WITH_THREADS)
+		// Frames are decoded ahead on a separate thread, the main thread only uploads them
+		_decoderRunning = true;
+		_decoderThread.Run(DecoderThread, this);
+#	if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+		_decoderThread.SetName("Cinematics decoding");
+#	endif
+#endif
+
 #ifdef WITH_OPENMPT
 		_music = resolver.GetMusic(path + ".j2b"_s);
 		if (_music != nullptr) {
@@ -51,6 +68,18 @@ namespace Jazz2::UI
 
 	Cinematics::~Cinematics()
 	{
+#if defined(WITH_THREADS)
+		if (_decoderRunning) {
+			_frameMutex.Lock();
+			_decoderQuit = true;
+			_frameCondition.Signal();
+			_frameMutex.Unlock();
+
+			_decoderThread.Join();
+			_decoderRunning = false;
+		}
+#endif
+
 		_canvas->setParent(nullptr);
 	}
 
@@ -67,10 +96,28 @@ namespace Jazz2::UI
 
 		_frameProgress += timeMult;
 
-		while (_frameProgress >= _frameDelay) {
+		// Only the last due frame is uploaded, skipped frames are just released back to the decoder
+		int32_t frameIndex = -1;
+		bool paletteChanged = false;
+		while (_frameProgress >= _frameDelay && _framesLeft > 0) {
+			int32_t nextIndex = PeekDecodedFrame(frameIndex >= 0 ? 1 : 0);
+			if (nextIndex < 0) {
+				// Decoder is late, try it again in the next frame
+				break;
+			}
+			if (frameIndex >= 0) {
+				ReleaseDecodedFrame();
+			}
+
+			frameIndex = nextIndex;
+			paletteChanged |= _frames[frameIndex].PaletteChanged;
 			_frameProgress -= _frameDelay;
 			_framesLeft--;
-			PrepareNextFrame();
+		}
+
+		if (frameIndex >= 0) {
+			UploadFrame(_frames[frameIndex], paletteChanged);
+			ReleaseDecodedFrame();
 		}
 
 		UpdatePressedActions();
@@ -159,10 +206,29 @@ namespace Jazz2::UI
 		_framesLeft = s->ReadValue<uint32_t>();
 		s->Seek(20, SeekOrigin::Current);
 
-		_texture = std::make_unique<Texture>("Cinematics", Texture::Format::RGBA8, _width, _height);
-		_buffer = std::make_unique<uint8_t[]>(_width * _height);
-		_lastBuffer = std::make_unique<uint8_t[]>(_width * _height);
-		_currentFrame = std::make_unique<uint32_t[]>(_width * _height);
+		_framesToDecode = _framesLeft;
+
+		// Palette is applied in shader, rows of 8-bit texture have to be aligned to 4 bytes
+		_alignedWidth = (_width + 3) & ~3;
+		_texture = std::make_unique<Texture>("Cinematics", Texture::Format::R8, _alignedWidth, _height);
+		_paletteTexture = std::make_unique<Texture>("CinematicsPalette", Texture::Format::RGBA8, 256, 1);
+		// Indices must not be interpolated, filtering is done in the shader after the palette lookup
+		_texture->setMinFiltering(SamplerFilter::Nearest);
+		_texture->setMagFiltering(SamplerFilter::Nearest);
+		_paletteTexture->setMinFiltering(SamplerFilter::Nearest);
+		_paletteTexture->setMagFiltering(SamplerFilter::Nearest);
+		if (_alignedWidth != _width) {
+			_uploadBuffer = std::make_unique<uint8_t[]>(_alignedWidth * _height);
+		}
+
+		// The first frame is decoded against the last (empty) frame in the ring
+		for (int i = 0; i < FrameRingSize; i++) {
+			_frames[i].Indices = std::make_unique<uint8_t[]>(_width * _height);
+			_frames[i].PaletteChanged = false;
+		}
+
+		std::memset(_palette, 0, sizeof(_palette));
+		_paletteTexture->loadFromTexels((unsigned char*)_palette, 0, 0, 256, 1);
 
 		// Read all 4 compressed streams
 		SmallVector<uint8_t, 0> compressedStreams[_countof(_decompressedStreams)];
@@ -197,66 +263,139 @@ namespace Jazz2::UI
 				LOGI_X("Cinematics stream %i was larger than expected, resizing buffer to %i", i, _decompressedStreams[i].size());
 				goto Retry;
 			}
+
+			decompressedSize = std::clamp(decompressedSize, 0, (int)_decompressedStreams[i].size());
+			_readers[i].Ptr = _decompressedStreams[i].begin();
+			_readers[i].End = _decompressedStreams[i].begin() + decompressedSize;
 		}
 
 		return true;
 	}
 
-	void Cinematics::PrepareNextFrame()
+	bool Cinematics::DecodeNextFrame()
 	{
+		if (_framesToDecode <= 0) {
+			return false;
+		}
+
+		_framesToDecode--;
+
+		// Previous slot always contains the last decoded frame, because only the decoder writes to the ring
+		DecodedFrame& frame = _frames[_frameWriteIndex];
+		const uint8_t* lastBuffer = _frames[(_frameWriteIndex + FrameRingSize - 1) % FrameRingSize].Indices.get();
+		uint8_t* buffer = frame.Indices.get();
+		const int32_t frameSize = (int32_t)(_width * _height);
+
 		// Check if palette was changed
-		if (ReadValue<uint8_t>(0) == 0x01) {
-			Read(3, _palette, sizeof(_palette));
+		frame.PaletteChanged = (_readers[0].ReadByte() == 0x01);
+		if (frame.PaletteChanged) {
+			_readers[3].Read(_palette, sizeof(_palette));
 		}
+		std::memcpy(frame.Palette, _palette, sizeof(_palette));
 
 		// Read pixels into the buffer
-		for (int y = 0; y < _height; y++) {
+		for (int32_t y = 0; y < (int32_t)_height; y++) {
+			int32_t x = y * (int32_t)_width;
 			uint8_t c;
-			int x = 0;
-			while ((c = ReadValue<uint8_t>(0)) != 0x80) {
+			while (_readers[0].Ptr < _readers[0].End && (c = _readers[0].ReadByte()) != 0x80) {
 				if (c < 0x80) {
-					int u;
-					if (c == 0x00) {
-						u = ReadValue<uint16_t>(0);
-					} else {
-						u = c;
-					}
+					int32_t u = (c == 0x00 ? _readers[0].ReadUInt16() : c);
+					u = std::min(u, frameSize - x);
 
 					// Read specified number of pixels in row
-					for (int i = 0; i < u; i++) {
-						_buffer[y * _width + x] = ReadValue<uint8_t>(3);
-						x++;
-					}
+					_readers[3].Read(&buffer[x], u);
+					x += u;
 				} else {
-					int u;
-					if (c == 0x81) {
-						u = ReadValue<uint16_t>(0);
-					} else {
-						u = c - 0x6A;
-					}
+					int32_t u = (c == 0x81 ? _readers[0].ReadUInt16() : c - 0x6A);
+					u = std::min(u, frameSize - x);
 
 					// Copy specified number of pixels from previous frame
-					int n = ReadValue<uint16_t>(1) + (ReadValue<uint8_t>(2) + y - 127) * _width;
-					for (int i = 0; i < u; i++) {
-						_buffer[y * _width + x] = _lastBuffer[n];
-						x++;
-						n++;
+					int32_t n = _readers[1].ReadUInt16();
+					n += (_readers[2].ReadByte() + y - 127) * (int32_t)_width;
+					if (n >= 0 && n + u <= frameSize) {
+						std::memcpy(&buffer[x], &lastBuffer[n], u);
+					} else {
+						std::memset(&buffer[x], 0, u);
 					}
+					x += u;
 				}
 			}
 		}
 
-		// Apply current palette to indices
-		for (int i = 0; i < _width * _height; i++) {
-			_currentFrame[i] = _palette[_buffer[i]];
+		_frameWriteIndex = (_frameWriteIndex + 1) % FrameRingSize;
+		return true;
+	}
+
+	int32_t Cinematics::PeekDecodedFrame(int32_t offset)
+	{
+#if defined(WITH_THREADS)
+		_frameMutex.Lock();
+		int32_t decodedFrameCount = _decodedFrameCount;
+		_frameMutex.Unlock();
+#else
+		// Frames are decoded on demand if threads are not available
+		if (_decodedFrameCount <= offset && DecodeNextFrame()) {
+			_decodedFrameCount++;
+		}
+		int32_t decodedFrameCount = _decodedFrameCount;
+#endif
+		return (decodedFrameCount > offset ? (_frameReadIndex + offset) % FrameRingSize : -1);
+	}
+
+	void Cinematics::ReleaseDecodedFrame()
+	{
+		_frameReadIndex = (_frameReadIndex + 1) % FrameRingSize;
+
+#if defined(WITH_THREADS)
+		_frameMutex.Lock();
+		_decodedFrameCount--;
+		_frameCondition.Signal();
+		_frameMutex.Unlock();
+#else
+		_decodedFrameCount--;
+#endif
+	}
+
+	void Cinematics::UploadFrame(const DecodedFrame& frame, bool paletteChanged)
+	{
+		const uint8_t* indices = frame.Indices.get();
+		if (_alignedWidth != _width) {
+			for (uint32_t y = 0; y < _height; y++) {
+				std::memcpy(&_uploadBuffer[y * _alignedWidth], &indices[y * _width], _width);
+			}
+			indices = _uploadBuffer.get();
+		}
+
+		// Upload new indices to GPU, palette is uploaded only if it was changed
+		_texture->loadFromTexels(indices, 0, 0, _alignedWidth, _height);
+		if (paletteChanged) {
+			_paletteTexture->loadFromTexels((const unsigned char*)frame.Palette, 0, 0, 256, 1);
 		}
+	}
 
-		// Upload new texture to GPU
-		_texture->loadFromTexels((unsigned char*)_currentFrame.get(), 0, 0, _width, _height);
+#if defined(WITH_THREADS)
+	void Cinematics::DecoderThread(void* arg)
+	{
+		Cinematics* _this = static_cast<Cinematics*>(arg);
 
-		// Create copy of the buffer
-		memcpy(_lastBuffer.get(), _buffer.get(), _width * _height);
+		while (true) {
+			_this->_frameMutex.Lock();
+			while (!_this->_decoderQuit && _this->_decodedFrameCount >= FrameRingSize) {
+				_this->_frameCondition.Wait(_this->_frameMutex);
+			}
+			bool shouldQuit = _this->_decoderQuit;
+			_this->_frameMutex.Unlock();
+
+			if (shouldQuit || !_this->DecodeNextFrame()) {
+				break;
+			}
+
+			_this->_frameMutex.Lock();
+			_this->_decodedFrameCount++;
+			_this->_frameMutex.Unlock();
+		}
 	}
+#endif
 
 	void Cinematics::UpdatePressedActions()
 	{
@@ -291,8 +430,8 @@ namespace Jazz2::UI
 
 	void Cinematics::CinematicsCanvas::Initialize()
 	{
-		// Prepare output render command
-		_renderCommand.material().setShaderProgramType(Material::ShaderProgramType::SPRITE);
+		// Prepare output render command, palette is applied to indices in the shader
+		_renderCommand.material().setShader(ContentResolver::Current().GetShader(PrecompiledShader::Cinematics));
 		_renderCommand.material().reserveUniformsDataMemory();
 		_renderCommand.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 
@@ -300,6 +439,10 @@ namespace Jazz2::UI
 		if (textureUniform && textureUniform->intValue(0) != 0) {
 			textureUniform->setIntValue(0); // GL_TEXTURE0
 		}
+		GLUniformCache* paletteUniform = _renderCommand.material().uniform("uPalette");
+		if (paletteUniform && paletteUniform->intValue(0) != 1) {
+			paletteUniform->setIntValue(1); // GL_TEXTURE1
+		}
 	}
 
 	bool Cinematics::CinematicsCanvas::OnDraw(RenderQueue& renderQueue)
@@ -315,13 +458,15 @@ namespace Jazz2::UI
 		// Try to adjust ratio a bit, otherwise show black bars
 		float ratio = std::clamp(ratioTarget, ratioSource - 0.16f, ratioSource);
 
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(viewSize.X, viewSize.X * ratio);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		// Texture may contain padding at the end of each row
+		_renderCommand.material().texRectUniform()->setFloatValue((float)_owner->_width / _owner->_alignedWidth, 0.0f, -1.0f, 1.0f);
+		_renderCommand.material().spriteSizeUniform()->setFloatValue(viewSize.X, viewSize.X * ratio);
+		_renderCommand.material().colorUniform()->setFloatVector(Colorf::White.Data());
+		_renderCommand.material().uniform("uFrameSize")->setFloatValue((float)_owner->_width, (float)_owner->_height);
 
 		_renderCommand.setTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
-		_renderCommand.material().setTexture(*_owner->_texture);
+		_renderCommand.material().setTexture(0, *_owner->_texture);
+		_renderCommand.material().setTexture(1, *_owner->_paletteTexture);
 
 		renderQueue.addCommand(&_renderCommand);
 
@@ -11,6 +11,11 @@
 #include "../../nCine/Input/InputEvents.h"
 #include "../../nCine/Audio/AudioStreamPlayer.h"
 
+#if defined(WITH_THREADS)
+#	include "../../nCine/Threading/Thread.h"
+#	include "../../nCine/Threading/ThreadSync.h"
+#endif
+
 #include <functional>
 
 namespace Jazz2::UI
@@ -20,6 +25,8 @@ namespace Jazz2::UI
 	public:
 		static constexpr int DefaultWidth = 720;
 		static constexpr int DefaultHeight = 405;
+		/// Number of frames that can be decoded ahead of playback
+		static constexpr int FrameRingSize = 4;
 
 		Cinematics(IRootController* root, const String& path, const std::function<bool(IRootController*, bool)>& callback);
 		~Cinematics() override;
@@ -34,6 +41,45 @@ namespace Jazz2::UI
 	private:
 		IRootController* _root;
 
+		/// Pointer-based reader of decompressed stream, reading past the end returns zeros
+		struct StreamReader
+		{
+			const uint8_t* Ptr;
+			const uint8_t* End;
+
+			inline uint8_t ReadByte() {
+				return (Ptr < End ? *Ptr++ : 0);
+			}
+
+			inline uint16_t ReadUInt16() {
+				if (End - Ptr < 2) {
+					Ptr = End;
+					return 0;
+				}
+				uint16_t value = (uint16_t)(Ptr[0] | (Ptr[1] << 8));
+				Ptr += 2;
+				return value;
+			}
+
+			inline void Read(void* buffer, uint32_t bytes) {
+				if (End - Ptr < (std::ptrdiff_t)bytes) {
+					memset(buffer, 0, bytes);
+					Ptr = End;
+				} else {
+					memcpy(buffer, Ptr, bytes);
+					Ptr += bytes;
+				}
+			}
+		};
+
+		/// Decoded frame with palette indices and palette that should be applied to them
+		struct DecodedFrame
+		{
+			std::unique_ptr<uint8_t[]> Indices;
+			uint32_t Palette[256];
+			bool PaletteChanged;
+		};
+
 		class CinematicsCanvas : public SceneNode
 		{
 		public:
@@ -52,6 +98,14 @@ namespace Jazz2::UI
 			RenderCommand _renderCommand;
 		};
 
+#if defined(WITH_THREADS)
+		Thread _decoderThread;
+		Mutex _frameMutex;
+		CondVariable _frameCondition;
+		bool _decoderQuit;
+		bool _decoderRunning;
+#endif
+
 		UI::UpscaleRenderPass _upscalePass;
 		std::unique_ptr<CinematicsCanvas> _canvas;
 		std::unique_ptr<AudioStreamPlayer> _music;
@@ -59,35 +113,31 @@ namespace Jazz2::UI
 		uint32_t _width, _height;
 		float _frameDelay, _frameProgress;
 		int _framesLeft;
+		uint32_t _alignedWidth;
 		std::unique_ptr<Texture> _texture;
-		std::unique_ptr<uint8_t[]> _buffer;
-		std::unique_ptr<uint8_t[]> _lastBuffer;
-		std::unique_ptr<uint32_t[]> _currentFrame;
-		uint32_t _palette[256];
+		std::unique_ptr<Texture> _paletteTexture;
+		std::unique_ptr<uint8_t[]> _uploadBuffer;
 		SmallVector<uint8_t, 0> _decompressedStreams[4];
-		uint32_t _currentOffsets[_countof(_decompressedStreams)];
+		StreamReader _readers[_countof(_decompressedStreams)];
+		uint32_t _palette[256];
+		DecodedFrame _frames[FrameRingSize];
+		int32_t _framesToDecode;
+		int32_t _frameReadIndex;
+		int32_t _frameWriteIndex;
+		int32_t _decodedFrameCount;
 
 		BitArray _pressedKeys;
 		uint32_t _pressedActions;
 
 		bool LoadFromFile(const String& path);
-		void PrepareNextFrame();
+		bool DecodeNextFrame();
+		int32_t PeekDecodedFrame(int32_t offset);
+		void ReleaseDecodedFrame();
+		void UploadFrame(const DecodedFrame& frame, bool paletteChanged);
 		void UpdatePressedActions();
 
-		inline void Read(int streamIndex, void* buffer, uint32_t bytes) {
-			if (_currentOffsets[streamIndex] + bytes > _decompressedStreams[streamIndex].size()) {
-				memset(buffer, 0, bytes);
-			} else {
-				memcpy(buffer, &_decompressedStreams[streamIndex][_currentOffsets[streamIndex]], bytes);
-			}
-			_currentOffsets[streamIndex] += bytes;
-		}
-
-		template<typename T>
-		inline T ReadValue(int streamIndex) {
-			T buffer;
-			Read(streamIndex, &buffer, sizeof(T));
-			return buffer;
-		}
+#if defined(WITH_THREADS)
+		static void DecoderThread(void* arg);
+#endif
 	};
 }
\ No newline at end of file
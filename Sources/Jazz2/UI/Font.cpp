@@ -6,6 +6,8 @@
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/IO/IFileStream.h"
 #include "../../nCine/Base/Random.h"
+#include "../../nCine/Base/HashFunctions.h"
+#include "../../nCine/Application.h"
 
 #include <Utf8.h>
 
@@ -14,7 +16,9 @@ namespace Jazz2::UI
 	Font::Font(const StringView& path, const uint32_t* palette)
 		:
 		_baseSpacing(0),
-		_charHeight(0)
+		_charHeight(0),
+		_textShader(nullptr),
+		_lastCacheCleanupFrame(0)
 	{
 		auto s = fs::Open(path + ".font"_s, FileAccessMode::Read);
 		auto fileSize = s->GetSize();
@@ -104,8 +108,116 @@ namespace Jazz2::UI
 			return;
 		}
 
+		unsigned long int frame = theApplication().numFrames();
+		if (frame - _lastCacheCleanupFrame >= LayoutCacheLifetime) {
+			_lastCacheCleanupFrame = frame;
+			for (auto it = _layoutCache.begin(); it != _layoutCache.end(); ) {
+				if (frame - it->second.LastUsedFrame >= LayoutCacheLifetime) {
+					it = _layoutCache.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		// Color and scale are applied as uniforms, so animating them doesn't require a new layout
+		Colorf baseColor;
+		float inlineAlpha;
+		LayoutParams params;
+		params.CharSpacing = charSpacing;
+		params.LineSpacing = lineSpacing;
+		if (color.R() == DefaultColor.R() && color.G() == DefaultColor.G() && color.B() == DefaultColor.B()) {
+			params.Color = LayoutColor::Default;
+			baseColor = Colorf(1.0f, 1.0f, 1.0f, color.A());
+			inlineAlpha = color.A();
+		} else {
+			if (color.R() == RandomColor.R() && color.G() == RandomColor.G() && color.B() == RandomColor.B()) {
+				params.Color = LayoutColor::Random;
+			} else if (color.R() == 0.0f && color.G() == 0.0f && color.B() == 0.0f) {
+				params.Color = LayoutColor::Shadow;
+			} else {
+				params.Color = LayoutColor::Custom;
+			}
+			baseColor = color;
+			inlineAlpha = std::min(color.A() * 2.0f, 1.0f);
+		}
+		// Only parity of the character offset matters, except for random colors, the rest is added to the wave phase
+		int32_t charOffsetPeriod = (params.Color == LayoutColor::Random ? 2 * (int32_t)_countof(RandomColors) : 2);
+		params.CharOffset = charOffset % charOffsetPeriod;
+		params.Align = (uint32_t)align;
+
+		uint64_t hash = fasthash64(text.data(), textSize, 0);
+		hash = fasthash64(&params, sizeof(LayoutParams), hash);
+
+		TextLayout* layout;
+		while (true) {
+			layout = &_layoutCache[hash];
+			if (layout->Text == text && std::memcmp(&layout->Params, &params, sizeof(LayoutParams)) == 0) {
+				break;
+			}
+			if (layout->LastUsedFrame != frame || layout->UsedRenderCommands == 0) {
+				// New string or a hash collision, layout is (re)built and it's kept until it's not used for a while
+				BuildLayout(*layout, text, params);
+				break;
+			}
+			// Commands of the colliding layout are already queued in this frame, so its vertices cannot be rebuilt
+			hash++;
+		}
+		if (layout->LastUsedFrame != frame) {
+			layout->LastUsedFrame = frame;
+			layout->UsedRenderCommands = 0;
+		}
+
 		// TODO: Revise this
-		float phase = canvas->AnimTime * speed * 16.0f;
+		float phase = canvas->AnimTime * speed * 16.0f + (float)(charOffset - params.CharOffset);
+		Vector4f wave;
+		if (angleOffset > 0.0f) {
+			wave = Vector4f(phase, angleOffset * fPi, varianceX * scale, varianceY * scale);
+		} else {
+			wave = Vector4f::Zero;
+		}
+
+		// Odd and even characters are drawn with separate commands, because odd ones should be one layer below
+		int maxGlyphsPerCommand = (int)(theApplication().appConfiguration().vboSize / (6 * sizeof(GlyphVertex)));
+		Matrix4x4f transformation = Matrix4x4f::Translation(x - canvas->ViewSize.X * 0.5f, canvas->ViewSize.Y * 0.5f - y, 0.0f);
+		for (int i = 0; i < 2; i++) {
+			int first = (i == 0 ? 0 : layout->OddGlyphCount);
+			int last = (i == 0 ? layout->OddGlyphCount : layout->GlyphCount);
+			for (; first < last; first += maxGlyphsPerCommand) {
+				int count = std::min(maxGlyphsPerCommand, last - first);
+				TextCommand& textCommand = RentRenderCommand(*layout);
+				RenderCommand* command = textCommand.Command.get();
+				command->geometry().setDrawParameters(GL_TRIANGLES, 0, count * 6);
+				command->geometry().setHostVertexPointer(&layout->Vertices[first * 6].X);
+				textCommand.Wave->setFloatVector(wave.Data());
+				textCommand.WaveAlternate->setFloatValue(speed > 0.0f ? 1.0f : 0.0f);
+				textCommand.Scale->setFloatValue(scale);
+				textCommand.Color->setFloatVector(baseColor.Data());
+				textCommand.InlineAlpha->setFloatValue(inlineAlpha);
+				command->setTransformation(transformation);
+				command->setLayer(i == 0 ? z - 1 : z);
+				canvas->_currentRenderQueue->addCommand(command);
+			}
+		}
+
+		charOffset += layout->GlyphCount + 1;
+	}
+
+	void Font::BuildLayout(TextLayout& layout, const StringView& text, const LayoutParams& params)
+	{
+		layout.Text = text;
+		layout.Params = params;
+		layout.Vertices.clear();
+		layout.OddGlyphCount = 0;
+		layout.GlyphCount = 0;
+		layout.UsedRenderCommands = 0;
+		layout.LastUsedFrame = 0;
+
+		size_t textSize = text.size();
+		float charSpacing = params.CharSpacing;
+		float lineSpacing = params.LineSpacing;
+		Alignment align = (Alignment)params.Align;
+		int charOffset = params.CharOffset;
 
 		// Maximum number of lines - center and right alignment starts to glitch if text has more lines, but it should be enough in most cases
 		constexpr int MaxLines = 16;
@@ -113,8 +225,6 @@ namespace Jazz2::UI
 		// Preprocessing
 		float totalWidth = 0.0f, lastWidth = 0.0f, totalHeight = 0.0f;
 		float lineWidths[MaxLines];
-		float charSpacingPre = charSpacing;
-		float scalePre = scale;
 
 		int idx = 0;
 		int line = 0;
@@ -129,7 +239,7 @@ namespace Jazz2::UI
 				lineWidths[line & (MaxLines - 1)] = lastWidth;
 				line++;
 				lastWidth = 0.0f;
-				totalHeight += (_charHeight * scale * lineSpacing);
+				totalHeight += (_charHeight * lineSpacing);
 			} else if (cursor.first == '\f') {
 				// Formatting
 				cursor = Death::Utf8::NextChar(text, cursor.second);
@@ -157,7 +267,7 @@ namespace Jazz2::UI
 				}
 
 				if (uvRect.W > 0 && uvRect.H > 0) {
-					lastWidth += (uvRect.W + _baseSpacing) * charSpacingPre * scalePre;
+					lastWidth += (uvRect.W + _baseSpacing) * charSpacing;
 				}
 			}
 
@@ -168,10 +278,10 @@ namespace Jazz2::UI
 			totalWidth = lastWidth;
 		}
 		lineWidths[line & (MaxLines - 1)] = lastWidth;
-		totalHeight += (_charHeight * scale * lineSpacing);
+		totalHeight += (_charHeight * lineSpacing);
 
-		// Rendering
-		Vector2f originPos = Vector2f(x - canvas->ViewSize.X * 0.5f, canvas->ViewSize.Y * 0.5f - y);
+		// Glyph quads are relative to the text origin and unscaled, origin is applied as transformation of the render command and scale in the shader
+		Vector2f originPos = Vector2f::Zero;
 		switch (align & Alignment::HorizontalMask) {
 			case Alignment::Center: originPos.X -= totalWidth * 0.5f; break;
 			case Alignment::Right: originPos.X -= totalWidth; break;
@@ -189,21 +299,16 @@ namespace Jazz2::UI
 		}
 
 		Vector2i texSize = _texture->size();
-		Shader* colorizeShader;
-		bool useRandomColor, isShadow;
-		float alpha;
-		if (color.R() == DefaultColor.R() && color.G() == DefaultColor.G() && color.B() == DefaultColor.B()) {
-			colorizeShader = nullptr;
-			useRandomColor = false;
-			isShadow = false;
-			alpha = color.A();
-			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-		} else {
-			colorizeShader = ContentResolver::Current().GetShader(PrecompiledShader::Colorize);
-			useRandomColor = (color.R() == RandomColor.R() && color.G() == RandomColor.G() && color.B() == RandomColor.B());
-			isShadow = (color.R() == 0.0f && color.G() == 0.0f && color.B() == 0.0f);
-			alpha = std::min(color.A() * 2.0f, 1.0f);
-		}
+		bool useColorize = (params.Color != LayoutColor::Default);
+		bool useRandomColor = (params.Color == LayoutColor::Random);
+		bool isShadow = (params.Color == LayoutColor::Shadow);
+		// Color of vertices is multiplied by the base color or by the alpha of inline colors in the shader, see ColorSource
+		Colorf color = Colorf::White;
+		float colorSource = (useRandomColor ? ColorSourceOwnBaseAlpha : ColorSourceBase);
+
+		static constexpr float Corners[6][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { -0.5f, 0.5f }, { -0.5f, 0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f } };
+
+		SmallVector<GlyphVertex, 0> evenVertices;
 
 		idx = 0;
 		line = 0;
@@ -218,7 +323,7 @@ namespace Jazz2::UI
 					case Alignment::Center: originPos.X += (totalWidth - lineWidths[line & (MaxLines - 1)]) * 0.5f; break;
 					case Alignment::Right: originPos.X += (totalWidth - lineWidths[line & (MaxLines - 1)]); break;
 				}
-				originPos.Y -= (_charHeight * scale * lineSpacing);
+				originPos.Y -= (_charHeight * lineSpacing);
 			} else if (cursor.first == '\f') {
 				// Formatting
 				cursor = Death::Utf8::NextChar(text, cursor.second);
@@ -256,10 +361,9 @@ namespace Jazz2::UI
 										unsigned long colorValue = strtoul(colorBuffer, &end, 16);
 										if (colorBuffer != end) {
 											color = Color(colorValue);
-											color.SetAlpha(0.5f * alpha * color.A());
-											if (colorizeShader == nullptr) {
-												colorizeShader = ContentResolver::Current().GetShader(PrecompiledShader::Colorize);
-											}
+											color.SetAlpha(0.5f * color.A());
+											colorSource = ColorSourceOwnInlineAlpha;
+											useColorize = true;
 										}
 									}
 								}
@@ -267,8 +371,9 @@ namespace Jazz2::UI
 						} else if (cursor.first == ']') {
 							// Reset color
 							if (!useRandomColor && !isShadow) {
-								color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-								colorizeShader = nullptr;
+								color = Colorf::White;
+								colorSource = ColorSourceOwnInlineAlpha;
+								useColorize = false;
 							}
 						}
 					}
@@ -292,68 +397,82 @@ namespace Jazz2::UI
 						color = Colorf(newColor.R(), newColor.G(), newColor.B(), color.A());
 					}
 
-					Vector2f pos = Vector2f(originPos);
-
-					if (angleOffset > 0.0f) {
-						float currentPhase = (phase + charOffset) * angleOffset * fPi;
-						if (speed > 0.0f && (charOffset % 2) == 1) {
-							currentPhase = -currentPhase;
-						}
-
-						pos.X += cosf(currentPhase) * varianceX * scale;
-						pos.Y -= sinf(currentPhase) * varianceY * scale;
-					}
-
-					pos.X = std::round(pos.X + uvRect.W * scale * 0.5f);
-					pos.Y = std::round(pos.Y - uvRect.H * scale * 0.5f);
-
-					Vector4f texCoords = Vector4f(
-						uvRect.W / float(texSize.X),
-						uvRect.X,
-						uvRect.H / float(texSize.Y),
-						uvRect.Y
-					);
-
-					texCoords.W += texCoords.Z;
-					texCoords.Z *= -1;
-
-					auto command = canvas->RentRenderCommand();
-					bool shaderChanged = (colorizeShader
-						? command->material().setShader(colorizeShader)
-						: command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE));
-					if (shaderChanged) {
-						command->material().reserveUniformsDataMemory();
-						command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
-						// Required to reset render command properly
-						command->setTransformation(command->transformation());
-
-						GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
-						if (textureUniform && textureUniform->intValue(0) != 0) {
-							textureUniform->setIntValue(0); // GL_TEXTURE0
-						}
+					float width = uvRect.W;
+					float height = uvRect.H;
+					float centerX = originPos.X + width * 0.5f;
+					float centerY = originPos.Y - height * 0.5f;
+					float texWidth = uvRect.W / float(texSize.X);
+					float texHeight = uvRect.H / float(texSize.Y);
+
+					auto& target = ((charOffset & 1) == 1 ? layout.Vertices : evenVertices);
+					for (int i = 0; i < 6; i++) {
+						GlyphVertex& v = target.emplace_back();
+						v.X = centerX;
+						v.Y = centerY;
+						v.OffsetX = Corners[i][0] * width;
+						v.OffsetY = Corners[i][1] * height;
+						v.U = uvRect.X + (Corners[i][0] + 0.5f) * texWidth;
+						v.V = uvRect.Y + (0.5f - Corners[i][1]) * texHeight;
+						v.R = color.R();
+						v.G = color.G();
+						v.B = color.B();
+						v.A = color.A();
+						v.Index = (float)charOffset;
+						v.Colorize = (useColorize ? 1.0f : 0.0f);
+						v.ColorSource = colorSource;
 					}
 
-					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(texCoords.Data());
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(uvRect.W * scale, uvRect.H * scale);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
-
-					// TODO: It looks better with the "0.5f" offset
-					command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y + 0.5f, 0.0f));
-					command->setLayer(z - (charOffset & 1));
-					command->material().setTexture(*_texture.get());
-
-					canvas->_currentRenderQueue->addCommand(command);
-
-					originPos.X += ((uvRect.W + _baseSpacing) * scale * charSpacing);
+					originPos.X += ((uvRect.W + _baseSpacing) * charSpacing);
 					charOffset++;
+					layout.GlyphCount++;
 				}
 			}
 
 			idx = cursor.second;
 		} while (idx < textSize);
-		charOffset++;
+
+		layout.OddGlyphCount = (int)(layout.Vertices.size() / 6);
+		layout.Vertices.append(evenVertices.begin(), evenVertices.end());
+	}
+
+	Font::TextCommand& Font::RentRenderCommand(TextLayout& layout)
+	{
+		if (layout.UsedRenderCommands < layout.RenderCommands.size()) {
+			TextCommand& textCommand = layout.RenderCommands[layout.UsedRenderCommands];
+			layout.UsedRenderCommands++;
+			return textCommand;
+		}
+
+		if (_textShader == nullptr) {
+			_textShader = ContentResolver::Current().GetShader(PrecompiledShader::Text);
+			_textShader->setAttribute("aPosition", sizeof(GlyphVertex), offsetof(GlyphVertex, X));
+			_textShader->setAttribute("aTexCoords", sizeof(GlyphVertex), offsetof(GlyphVertex, U));
+			_textShader->setAttribute("aColor", sizeof(GlyphVertex), offsetof(GlyphVertex, R));
+			_textShader->setAttribute("aGlyph", sizeof(GlyphVertex), offsetof(GlyphVertex, Index));
+		}
+
+		TextCommand& textCommand = layout.RenderCommands.emplace_back();
+		textCommand.Command = std::make_unique<RenderCommand>();
+		RenderCommand* command = textCommand.Command.get();
+		command->material().setShader(_textShader);
+		command->material().setBlendingEnabled(true);
+		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		command->material().reserveUniformsDataMemory();
+		command->geometry().setNumElementsPerVertex(sizeof(GlyphVertex) / sizeof(float));
+		command->material().setTexture(*_texture.get());
+		layout.UsedRenderCommands++;
+
+		GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+		if (textureUniform && textureUniform->intValue(0) != 0) {
+			textureUniform->setIntValue(0); // GL_TEXTURE0
+		}
+
+		// Uniforms are looked up by name only once, commands are reused in the next frames
+		textCommand.Wave = command->material().uniform("uWave");
+		textCommand.WaveAlternate = command->material().uniform("uWaveAlternate");
+		textCommand.Scale = command->material().uniform("uScale");
+		textCommand.Color = command->material().uniform("uColor");
+		textCommand.InlineAlpha = command->material().uniform("uInlineAlpha");
+		return textCommand;
 	}
 }
\ No newline at end of file
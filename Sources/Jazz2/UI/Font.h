@@ -4,6 +4,8 @@
 #include "../../nCine/Primitives/Colorf.h"
 #include "../../nCine/Primitives/Rect.h"
 #include "../../nCine/Base/HashMap.h"
+#include "../../nCine/Graphics/GL/GLUniformCache.h"
+#include "../../nCine/Graphics/Shader.h"
 #include "../../nCine/Graphics/Texture.h"
 
 using namespace nCine;
@@ -21,7 +23,66 @@ namespace Jazz2::UI
 
 		void DrawString(Canvas* canvas, const StringView& text, int& charOffset, float x, float y, uint16_t z, Alignment align, Colorf color, float scale = 1.0f, float angleOffset = 0.0f, float varianceX = 4.0f, float varianceY = 4.0f, float speed = 0.4f, float charSpacing = 1.0f, float lineSpacing = 1.0f);
 
+		/// Vertex of a glyph quad, the wave animation is applied in the vertex shader
+		struct GlyphVertex {
+			float X, Y;
+			float OffsetX, OffsetY;
+			float U, V;
+			float R, G, B, A;
+			float Index, Colorize, ColorSource;
+		};
+
 	private:
+		/// How glyph colors are derived from the color of the string, the color itself and scale are applied as uniforms
+		enum class LayoutColor : uint32_t {
+			Default,
+			Custom,
+			Random,
+			Shadow
+		};
+
+		/// Glyph uses the base color of the string
+		static constexpr float ColorSourceBase = 0.0f;
+		/// Glyph uses its own color with alpha of the string
+		static constexpr float ColorSourceOwnBaseAlpha = 1.0f;
+		/// Glyph uses its own color with alpha of inline colors
+		static constexpr float ColorSourceOwnInlineAlpha = 2.0f;
+
+		/// Parameters that affect the generated glyph quads, all fields must be 4 bytes wide to be hashed without padding
+		struct LayoutParams {
+			float CharSpacing;
+			float LineSpacing;
+			LayoutColor Color;
+			/// Character offset reduced to the period of odd/even layers and random colors
+			int32_t CharOffset;
+			uint32_t Align;
+		};
+
+		/// Render command of a layout with uniforms resolved when the command is created
+		struct TextCommand {
+			std::unique_ptr<RenderCommand> Command;
+			GLUniformCache* Wave;
+			GLUniformCache* WaveAlternate;
+			GLUniformCache* Scale;
+			GLUniformCache* Color;
+			GLUniformCache* InlineAlpha;
+		};
+
+		/// Cached layout of one string, odd characters are stored before even ones, because they are drawn one layer below
+		struct TextLayout {
+			String Text;
+			LayoutParams Params;
+			SmallVector<GlyphVertex, 0> Vertices;
+			SmallVector<TextCommand, 0> RenderCommands;
+			int OddGlyphCount = 0;
+			int GlyphCount = 0;
+			unsigned int UsedRenderCommands = 0;
+			unsigned long int LastUsedFrame = 0;
+		};
+
+		/// Number of frames an unused layout is kept in the cache
+		static constexpr unsigned long int LayoutCacheLifetime = 60;
+
 		static constexpr Colorf RandomColors[] = {
 			Colorf(0.4f, 0.55f, 0.85f, 0.5f),
 			Colorf(0.7f, 0.45f, 0.42f, 0.5f),
@@ -38,5 +99,11 @@ namespace Jazz2::UI
 		HashMap<uint32_t, Rectf> _unicodeChars;
 		int _baseSpacing, _charHeight;
 		std::unique_ptr<Texture> _texture;
+		Shader* _textShader;
+		HashMap<uint64_t, TextLayout> _layoutCache;
+		unsigned long int _lastCacheCleanupFrame;
+
+		void BuildLayout(TextLayout& layout, const StringView& text, const LayoutParams& params);
+		TextCommand& RentRenderCommand(TextLayout& layout);
 	};
 }
\ No newline at end of file
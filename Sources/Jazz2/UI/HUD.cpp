@@ -2,9 +2,15 @@
 #include "ControlScheme.h"
 #include "../LevelHandler.h"
 #include "../PreferencesCache.h"
+#include "../Actors/ActorPool.h"
 #include "../Actors/Enemies/Bosses/BossBase.h"
 
+#if defined(WITH_ANGELSCRIPT)
+#	include "../Scripting/LevelScripts.h"
+#endif
+
 #include "../../nCine/Graphics/RenderQueue.h"
+#include "../../nCine/Graphics/RenderStatistics.h"
 #include "../../nCine/IO/IFileStream.h"
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Application.h"
@@ -292,9 +298,7 @@ namespace Jazz2::UI
 
 			// FPS
 			if (PreferencesCache::ShowPerformanceMetrics) {
-				i32tos((int)std::round(theApplication().averageFps()), stringBuffer);
-				_smallFont->DrawString(this, stringBuffer, charOffset, view.W - 4, 0, FontLayer,
-					Alignment::TopRight, Font::DefaultColor, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+				DrawPerformanceMetrics(charOffset, view.W - 4);
 			}
 
 			// Touch Controls
@@ -342,10 +346,9 @@ namespace Jazz2::UI
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(Vector4f(1.0f, 0.0f, 1.0f, 0.0f).Data());
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(Vector2f(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y)).Data());
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
+			command->material().texRectUniform()->setFloatVector(Vector4f(1.0f, 0.0f, 1.0f, 0.0f).Data());
+			command->material().spriteSizeUniform()->setFloatVector(Vector2f(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y)).Data());
+			command->material().colorUniform()->setFloatVector(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
 
 			command->setTransformation(Matrix4x4f::Identity);
 			command->setLayer(999);
@@ -626,6 +629,76 @@ namespace Jazz2::UI
 		}
 	}
 
+	void HUD::DrawPerformanceMetrics(int& charOffset, float x)
+	{
+		constexpr float LineHeight = 10.0f;
+
+		char stringBuffer[64];
+		float y = 0.0f;
+
+		i32tos((int)std::round(theApplication().averageFps()), stringBuffer);
+		_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+			Alignment::TopRight, Font::DefaultColor, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+		y += LineHeight;
+
+		// Pooled actor allocations (live/reserved slots, allocations in this frame)
+		auto& poolStats = Actors::ActorPool::GetStatistics();
+		formatString(stringBuffer, sizeof(stringBuffer), "Pool %u/%u +%u", poolStats.LiveSlots, poolStats.ReservedSlots, poolStats.FrameAllocations);
+		_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+			Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+		y += LineHeight;
+
+		// Actors per update tier (full/reduced/dormant)
+		formatString(stringBuffer, sizeof(stringBuffer), "Actors %u/%u/%u", _levelHandler->_actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Full],
+			_levelHandler->_actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Reduced], _levelHandler->_actorsPerUpdateTier[(int)Actors::ActorUpdateTier::Dormant]);
+		_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+			Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+		y += LineHeight;
+
+		// Debris particles (count, update time)
+		if (_levelHandler->_tileMap != nullptr) {
+			formatString(stringBuffer, sizeof(stringBuffer), "Debris %i %.2fms", _levelHandler->_tileMap->GetDebrisCount(), _levelHandler->_tileMap->GetDebrisUpdateTime());
+			_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+				Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+			y += LineHeight;
+		}
+
+		// Lights (visible/emitted, preparation time)
+		if (_levelHandler->_lightingRenderer != nullptr) {
+			auto* lightingRenderer = _levelHandler->_lightingRenderer.get();
+			formatString(stringBuffer, sizeof(stringBuffer), "Lights %i/%i %.2fms", lightingRenderer->GetVisibleLightCount(),
+				lightingRenderer->GetEmittedLightCount(), lightingRenderer->GetDrawTime());
+			_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+				Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+			y += LineHeight;
+		}
+
+#if defined(WITH_ANGELSCRIPT)
+		// Scripts (execution time, the slowest function in the last frame)
+		if (_levelHandler->_scripts != nullptr) {
+			auto& scriptStats = _levelHandler->_scripts->GetFrameStatistics();
+			formatString(stringBuffer, sizeof(stringBuffer), "Scripts %.2fms%s", scriptStats.TotalTime,
+				scriptStats.IsSuspended ? " (suspended)" : (scriptStats.IsOverBudget ? " (over budget)" : ""));
+			_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+				Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+			y += LineHeight;
+
+			if (scriptStats.SlowestFunctionName != nullptr) {
+				formatString(stringBuffer, sizeof(stringBuffer), "%s %.2fms", scriptStats.SlowestFunctionName, scriptStats.SlowestFunctionTime);
+				_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+					Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+				y += LineHeight;
+			}
+		}
+#endif
+
+		// Cached tile chunks (commands/replaced tile commands, rebuilds)
+		auto& cachedStats = RenderStatistics::cachedCommands();
+		formatString(stringBuffer, sizeof(stringBuffer), "Chunks %u/%u +%u", cachedStats.commands, cachedStats.replacedCommands, cachedStats.rebuilds);
+		_smallFont->DrawString(this, stringBuffer, charOffset, x, y, FontLayer,
+			Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+	}
+
 	void HUD::DrawElement(const StringView& name, int frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending, float angle)
 	{
 		auto it = _graphics->find(String::nullTerminatedView(name));
@@ -995,10 +1068,9 @@ namespace Jazz2::UI
 
 		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(1.0f, 1.0f);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->material().texRectUniform()->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+		command->material().spriteSizeUniform()->setFloatValue(1.0f, 1.0f);
+		command->material().colorUniform()->setFloatVector(color.Data());
 
 		command->setTransformation(Matrix4x4f::Identity);
 		command->setLayer(z);
@@ -19,6 +19,7 @@ namespace Jazz2::UI::Menu
 		_items[(int)Item::Fullscreen].Name = "Fullscreen"_s;
 #endif
 		_items[(int)Item::Antialiasing].Name = "Antialiasing"_s;
+		_items[(int)Item::BlurQuality].Name = "Blur Quality"_s;
 		_items[(int)Item::ShowPerformanceMetrics].Name = "Performance Metrics"_s;
 	}
 
@@ -108,7 +109,18 @@ namespace Jazz2::UI::Menu
 					Alignment::Center, Font::DefaultColor, 0.9f);
 			}
 
-			if (i >= 1) {
+			if (i == (int)Item::BlurQuality) {
+				StringView value;
+				switch (PreferencesCache::ActiveBlurQuality) {
+					default:
+					case BlurQuality::Off: value = "Disabled"_s; break;
+					case BlurQuality::Low: value = "Low"_s; break;
+					case BlurQuality::High: value = "High"_s; break;
+				}
+
+				_root->DrawStringShadow(value, charOffset, center.X, center.Y + 22.0f, IMenuContainer::FontLayer - 10,
+					Alignment::Center, (_selectedIndex == i ? Colorf(0.46f, 0.46f, 0.46f, 0.5f) : Font::DefaultColor), 0.8f);
+			} else if (i >= 1) {
 				bool enabled;
 				switch (i) {
 					default:
@@ -197,6 +209,14 @@ namespace Jazz2::UI::Menu
 				_root->PlaySfx("MenuSelect"_s, 0.6f);
 				break;
 			}
+			case (int)Item::BlurQuality:
+				PreferencesCache::ActiveBlurQuality = (PreferencesCache::ActiveBlurQuality == BlurQuality::High
+					? BlurQuality::Off : (BlurQuality)((uint8_t)PreferencesCache::ActiveBlurQuality + 1));
+				_root->ApplyPreferencesChanges(ChangedPreferencesType::Graphics);
+				_isDirty = true;
+				_animation = 0.0f;
+				_root->PlaySfx("MenuSelect"_s, 0.6f);
+				break;
 			case (int)Item::ShowPerformanceMetrics:
 				PreferencesCache::ShowPerformanceMetrics = !PreferencesCache::ShowPerformanceMetrics;
 				_isDirty = true;
@@ -22,6 +22,7 @@ namespace Jazz2::UI::Menu
 			Fullscreen,
 #endif
 			Antialiasing,
+			BlurQuality,
 			ShowPerformanceMetrics,
 
 			Count
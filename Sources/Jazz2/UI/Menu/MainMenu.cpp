@@ -599,10 +599,9 @@ namespace Jazz2::UI::Menu
 		Vector2i viewSize = _canvasBackground->ViewSize;
 		auto command = &_texturedBackgroundPass._outputRenderCommand;
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		command->material().texRectUniform()->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+		command->material().spriteSizeUniform()->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
+		command->material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		command->material().uniform("uViewSize")->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
 		command->material().uniform("uShift")->setFloatVector(_texturedBackgroundPos.Data());
@@ -692,10 +691,9 @@ namespace Jazz2::UI::Menu
 					texBiasY -= 0.5f / float(texSize.Y);
 				}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().texRectUniform()->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->material().spriteSizeUniform()->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				command->material().colorUniform()->setFloatVector(Colorf::White.Data());
 
 				command->setTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), y * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), 0.0f));
 				command->material().setTexture(*_owner->_tileSet->TextureDiffuse);
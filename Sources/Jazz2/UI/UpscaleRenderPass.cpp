@@ -135,20 +135,19 @@ namespace Jazz2::UI
 
 	bool UpscaleRenderPass::OnDraw(RenderQueue& renderQueue)
 	{
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
 #if defined(ALLOW_RESCALE_SHADERS)
 		if (_resizeShader != nullptr) {
 			// TexRectUniformName is reused for input texture size
 			Vector2i size = _target->size();
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue((float)size.X, (float)size.Y, 0.0f, 0.0f);
+			_renderCommand.material().texRectUniform()->setFloatValue((float)size.X, (float)size.Y, 0.0f, 0.0f);
 		} else
 #endif
 		{
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
+			_renderCommand.material().texRectUniform()->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
 		}
 
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(_targetSize.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		_renderCommand.material().spriteSizeUniform()->setFloatVector(_targetSize.Data());
+		_renderCommand.material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		_renderCommand.material().setTexture(0, *_target);
 
@@ -167,10 +166,9 @@ namespace Jazz2::UI
 	bool UpscaleRenderPass::AntialiasingSubpass::OnDraw(RenderQueue& renderQueue)
 	{
 		Vector2i size = _target->size();
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue((float)size.X, (float)size.Y, 0.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(_targetSize.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		_renderCommand.material().texRectUniform()->setFloatValue((float)size.X, (float)size.Y, 0.0f, 0.0f);
+		_renderCommand.material().spriteSizeUniform()->setFloatVector(_targetSize.Data());
+		_renderCommand.material().colorUniform()->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		_renderCommand.material().setTexture(0, *_target);
 
@@ -119,6 +119,8 @@ void GameEventHandler::onPreInit(AppConfiguration& config)
 
 	config.windowTitle = "Jazz² Resurrection"_s;
 	config.withVSync = PreferencesCache::EnableVsync;
+	config.withAudioCapture = PreferencesCache::EnableAudioCapture;
+	config.audioCaptureFile = PreferencesCache::AudioCapturePath;
 	config.resolution.Set(LevelHandler::DefaultWidth, LevelHandler::DefaultHeight);
 }
 
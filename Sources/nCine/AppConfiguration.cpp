@@ -42,6 +42,10 @@ namespace nCine
 		withAudio(true),
 		withThreads(false),
 		withScenegraph(true),
+		withThreadedAudio(true),
+		audioStreamBufferCount(3),
+		audioStreamBufferSize(16 * 1024),
+		withAudioCapture(false),
 		withVSync(true),
 		withGlDebugContext(false),
 
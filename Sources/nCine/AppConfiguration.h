@@ -76,6 +76,17 @@ namespace nCine
 		bool withThreads;
 		/// The flag is `true` if the scenegraph based rendering is enabled
 		bool withScenegraph;
+		/// The flag is `true` if audio streams are decoded and queued on a dedicated thread instead of the main one
+		/*! \note The value is only taken into account when the engine is compiled with threads support */
+		bool withThreadedAudio;
+		/// The number of OpenAL buffers queued by each audio stream
+		unsigned int audioStreamBufferCount;
+		/// The size in bytes of each buffer queued by audio streams
+		unsigned int audioStreamBufferSize;
+		/// The flag is `true` if the audio output is rendered offline instead of being played by the audio device
+		bool withAudioCapture;
+		/// The path of the WAV file the captured audio output is written to, the output is discarded if it's empty
+		String audioCaptureFile;
 		/// The flag is `true` if the vertical synchronization is enabled
 		bool withVSync;
 		/// The flag is `true` if the OpenGL debug context is enabled
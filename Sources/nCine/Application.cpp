@@ -63,6 +63,7 @@ extern "C"
 
 #if defined(WITH_AUDIO)
 #	include "Audio/ALAudioDevice.h"
+#	include "Audio/CaptureAudioDevice.h"
 #endif
 
 #if defined(WITH_THREADS)
@@ -303,7 +304,14 @@ namespace nCine
 		theServiceLocator().registerIndexer(std::make_unique<ArrayIndexer>());
 #if defined(WITH_AUDIO)
 		if (appCfg_.withAudio) {
-			theServiceLocator().registerAudioDevice(std::make_unique<ALAudioDevice>());
+#	if defined(ALC_SOFT_loopback)
+			if (appCfg_.withAudioCapture) {
+				theServiceLocator().registerAudioDevice(std::make_unique<CaptureAudioDevice>(appCfg_, appCfg_.audioCaptureFile));
+			} else
+#	endif
+			{
+				theServiceLocator().registerAudioDevice(std::make_unique<ALAudioDevice>(appCfg_));
+			}
 		}
 #endif
 #if defined(WITH_THREADS)
@@ -340,6 +348,10 @@ namespace nCine
 		TracyGpuCollect;
 
 		frameTimer_ = std::make_unique<FrameTimer>(appCfg_.frameTimerLogInterval, appCfg_.profileTextUpdateTime());
+#if defined(WITH_AUDIO)
+		// Captured audio is rendered for the game time, so the capture is reproducible and can run faster than real time
+		frameTimer_->setFixedStep(appCfg_.withAudioCapture);
+#endif
 
 		if (appCfg_.withScenegraph) {
 			gfxDevice_->setupGL();
@@ -1,7 +1,14 @@
 #include "ALAudioDevice.h"
+#include "AudioBuffer.h"
 #include "AudioBufferPlayer.h"
 #include "AudioStreamPlayer.h"
+#include "../AppConfiguration.h"
 #include "../ServiceLocator.h"
+#include "../Base/Timer.h"
+#include "../CommonConstants.h"
+
+#include <cmath>
+#include <cstring>
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)
 #	include <Environment.h>
@@ -16,17 +23,43 @@ namespace nCine
 	// CONSTRUCTORS and DESTRUCTOR
 	///////////////////////////////////////////////////////////
 
-	ALAudioDevice::ALAudioDevice()
-		: device_(nullptr), context_(nullptr), gain_(1.0f), sources_ { }, deviceName_(nullptr), nativeFreq_(44100)
+	ALAudioDevice::ALAudioDevice(const AppConfiguration& appCfg)
+		: ALAudioDevice(appCfg, false)
+	{
+	}
+
+	ALAudioDevice::ALAudioDevice(const AppConfiguration& appCfg, bool isLoopback)
+		: device_(nullptr), context_(nullptr), gain_(1.0f), sources_ { }, mixSourceId_(UnavailableSource), mixBuffers_ { }, listenerPos_(0.0f, 0.0f, 0.0f), deviceName_(nullptr), nativeFreq_(44100)
+#if defined(WITH_THREADS)
+		, streamThreadQuit_(false), streamThreadRunning_(false)
+#endif
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)
 		, alcReopenDeviceSOFT_(nullptr), pEnumerator_(nullptr), lastDeviceChangeTime_(0), shouldRecreate_(false)
 #endif
 	{
-		device_ = alcOpenDevice(nullptr);
+		const ALCint* contextAttributes = nullptr;
+#if defined(ALC_SOFT_loopback)
+		const ALCint loopbackAttributes[] = {
+			ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+			ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+			ALC_FREQUENCY, LoopbackFrequency,
+			0
+		};
+		if (isLoopback) {
+			auto alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT");
+			RETURN_ASSERT_MSG(alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback") && alcLoopbackOpenDeviceSOFT != nullptr,
+				"ALC_SOFT_loopback extension is not supported");
+			device_ = alcLoopbackOpenDeviceSOFT(nullptr);
+			contextAttributes = loopbackAttributes;
+		} else
+#endif
+		{
+			device_ = alcOpenDevice(nullptr);
+		}
 		RETURN_ASSERT_MSG_X(device_ != nullptr, "alcOpenDevice failed: 0x%x", alGetError());
 		deviceName_ = alcGetString(device_, ALC_DEVICE_SPECIFIER);
 
-		context_ = alcCreateContext(device_, nullptr);
+		context_ = alcCreateContext(device_, contextAttributes);
 		if (context_ == nullptr) {
 			alcCloseDevice(device_);
 			RETURN_MSG_X("alcCreateContext failed: 0x%x", alGetError());
@@ -54,8 +87,27 @@ namespace nCine
 			LOGE_X("alGenSources failed: 0x%x", error);
 		}
 
+		if (error == AL_NO_ERROR) {
+			// The first source is reserved for the software mixer, it plays sounds that don't get a source of their own
+			alGenBuffers(MixBufferCount, mixBuffers_);
+			if (alGetError() == AL_NO_ERROR) {
+				mixSourceId_ = sources_[0];
+				for (ALuint bufferId : mixBuffers_) {
+					mixFreeBuffers_.push_back(bufferId);
+				}
+				// Voices are positioned by the mixer, so the source stays at the listener without attenuation
+				alSourcei(mixSourceId_, AL_SOURCE_RELATIVE, AL_TRUE);
+				alSource3f(mixSourceId_, AL_POSITION, 0.0f, 0.0f, 0.0f);
+				alSourcef(mixSourceId_, AL_ROLLOFF_FACTOR, 0.0f);
+			} else {
+				LOGW("alGenBuffers failed, software mixing of sounds is disabled");
+			}
+		}
+
 		for (int i = MaxSources - 1; i >= 0; i--) {
-			sourcePool_.push_back(sources_[i]);
+			if (sources_[i] != mixSourceId_) {
+				sourcePool_.push_back(sources_[i]);
+			}
 		}
 
 		alDistanceModel(AL_LINEAR_DISTANCE_CLAMPED);
@@ -71,13 +123,35 @@ namespace nCine
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)
 		// Try to use ALC_SOFT_reopen_device extension to reopen the device
-		alcReopenDeviceSOFT_ = (LPALCREOPENDEVICESOFT)alGetProcAddress("alcReopenDeviceSOFT");
-		registerAudioEvents();
+		if (!isLoopback) {
+			alcReopenDeviceSOFT_ = (LPALCREOPENDEVICESOFT)alGetProcAddress("alcReopenDeviceSOFT");
+			registerAudioEvents();
+		}
+#endif
+
+#if defined(WITH_THREADS)
+		// Loopback device is rendered on the main thread, so streams are updated there too to stay in sync
+		if (appCfg.withThreadedAudio && !isLoopback) {
+			// The context is current for the whole process, so the streaming thread can use it too
+			streamThreadRunning_ = true;
+			streamThread_.Run(streamThreadFunction, this);
+#	if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+			streamThread_.SetName("Audio streaming");
+#	endif
+		}
 #endif
 	}
 
 	ALAudioDevice::~ALAudioDevice()
 	{
+#if defined(WITH_THREADS)
+		if (streamThreadRunning_) {
+			streamThreadQuit_ = true;
+			streamThread_.Join();
+			streamThreadRunning_ = false;
+		}
+#endif
+
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)
 		unregisterAudioEvents();
 #endif
@@ -86,6 +160,9 @@ namespace nCine
 			alSourcei(sourceId, AL_BUFFER, AL_NONE);
 		}
 		alDeleteSources(MaxSources, sources_);
+		if (mixSourceId_ != UnavailableSource) {
+			alDeleteBuffers(MixBufferCount, mixBuffers_);
+		}
 
 		alcDestroyContext(context_);
 
@@ -108,6 +185,10 @@ namespace nCine
 		if (index < players_.size()) {
 			return players_[index];
 		}
+		index -= (unsigned int)players_.size();
+		if (index < mixVoices_.size()) {
+			return mixVoices_[index].player;
+		}
 		return nullptr;
 	}
 
@@ -117,6 +198,12 @@ namespace nCine
 			player->stop();
 		}
 		players_.clear();
+
+		// Stopped voices remove themselves from the array
+		for (int i = (int)mixVoices_.size() - 1; i >= 0; i--) {
+			mixVoices_[i].player->stop();
+		}
+		mixVoices_.clear();
 	}
 
 	void ALAudioDevice::pausePlayers()
@@ -125,6 +212,11 @@ namespace nCine
 			player->pause();
 		}
 		players_.clear();
+
+		// Paused voices stay in the array, so they can be resumed later
+		for (auto& voice : mixVoices_) {
+			voice.player->pause();
+		}
 	}
 
 	void ALAudioDevice::stopPlayers(PlayerType playerType)
@@ -139,6 +231,12 @@ namespace nCine
 				players_.erase(&players_[i]);
 			}
 		}
+
+		if (playerType == PlayerType::Buffer) {
+			for (int i = (int)mixVoices_.size() - 1; i >= 0; i--) {
+				mixVoices_[i].player->stop();
+			}
+		}
 	}
 
 	void ALAudioDevice::pausePlayers(PlayerType playerType)
@@ -153,6 +251,12 @@ namespace nCine
 				players_.erase(&players_[i]);
 			}
 		}
+
+		if (playerType == PlayerType::Buffer) {
+			for (auto& voice : mixVoices_) {
+				voice.player->pause();
+			}
+		}
 	}
 
 	void ALAudioDevice::freezePlayers()
@@ -160,6 +264,9 @@ namespace nCine
 		for (auto& player : players_) {
 			player->pause();
 		}
+		for (auto& voice : mixVoices_) {
+			voice.player->pause();
+		}
 		// The players array is not cleared at this point, it is needed as-is by the unfreeze method
 	}
 
@@ -168,12 +275,64 @@ namespace nCine
 		for (auto& player : players_) {
 			player->play();
 		}
+		for (auto& voice : mixVoices_) {
+			voice.player->play();
+		}
 	}
 
 	unsigned int ALAudioDevice::registerPlayer(IAudioPlayer* player)
 	{
+		float audibility = calculateAudibility(player);
+
+		if (player->type() == AudioBufferPlayer::sType()) {
+			if (audibility <= 0.0f && !player->isLooping_) {
+				// Sound is too far to be heard, looping sounds are allowed, because the listener may come closer
+				return UnavailableSource;
+			}
+
+			// Limit number of players of the same buffer, the least audible one is replaced if the new one is louder
+			const AudioBuffer* audioBuffer = static_cast<AudioBufferPlayer*>(player)->audioBuffer();
+			IAudioPlayer* weakestPlayer = nullptr;
+			float weakestAudibility = 0.0f;
+			unsigned int voiceCount = 0;
+			for (IAudioPlayer* otherPlayer : players_) {
+				if (otherPlayer->type() == AudioBufferPlayer::sType() && static_cast<AudioBufferPlayer*>(otherPlayer)->audioBuffer() == audioBuffer) {
+					voiceCount++;
+					float otherAudibility = calculateAudibility(otherPlayer);
+					if (weakestPlayer == nullptr || otherAudibility < weakestAudibility) {
+						weakestPlayer = otherPlayer;
+						weakestAudibility = otherAudibility;
+					}
+				}
+			}
+			for (const MixVoice& voice : mixVoices_) {
+				if (voice.player->audioBuffer() == audioBuffer) {
+					voiceCount++;
+					float otherAudibility = calculateAudibility(voice.player);
+					if (weakestPlayer == nullptr || otherAudibility < weakestAudibility) {
+						weakestPlayer = voice.player;
+						weakestAudibility = otherAudibility;
+					}
+				}
+			}
+			if (voiceCount >= MaxVoicesPerBuffer) {
+				if (weakestAudibility > audibility) {
+					return UnavailableSource;
+				}
+				weakestPlayer->stop();
+			}
+		}
+
 		if (sourcePool_.empty()) {
-			return UnavailableSource;
+			// Short sounds are mixed in software instead of cutting off another player
+			if (canMixPlayer(player)) {
+				mixVoices_.push_back({ static_cast<AudioBufferPlayer*>(player), 0.0f, 0.0f, 0.0f });
+				return MixedSource;
+			}
+			if (!stealSource(player, audibility)) {
+				LOGW("No more available audio sources for playing");
+				return UnavailableSource;
+			}
 		}
 
 		ALuint sourceId = sourcePool_.pop_back_val();
@@ -182,6 +341,16 @@ namespace nCine
 			players_.push_back(player);
 		}
 
+#if defined(WITH_THREADS)
+		if (streamThreadRunning_ && player->type() == AudioStreamPlayer::sType()) {
+			AudioStreamPlayer* streamPlayer = static_cast<AudioStreamPlayer*>(player);
+			streamPlayer->isStreamThreaded_ = true;
+			streamPlayersMutex_.Lock();
+			streamPlayers_.push_back(streamPlayer);
+			streamPlayersMutex_.Unlock();
+		}
+#endif
+
 		return sourceId;
 	}
 
@@ -191,6 +360,39 @@ namespace nCine
 			return;
 		}
 
+		if (player->sourceId_ == MixedSource) {
+			for (unsigned int i = 0; i < mixVoices_.size(); i++) {
+				if (mixVoices_[i].player == player) {
+					mixVoices_.erase(&mixVoices_[i]);
+					break;
+				}
+			}
+			player->sourceId_ = UnavailableSource;
+			return;
+		}
+
+#if defined(WITH_THREADS)
+		if (streamThreadRunning_ && player->type() == AudioStreamPlayer::sType()) {
+			AudioStreamPlayer* streamPlayer = static_cast<AudioStreamPlayer*>(player);
+			if (streamPlayer->isStreamThreaded_) {
+				streamPlayer->isStreamThreaded_ = false;
+				streamPlayersMutex_.Lock();
+				for (unsigned int i = 0; i < streamPlayers_.size(); i++) {
+					if (streamPlayers_[i] == streamPlayer) {
+						streamPlayers_[i] = streamPlayers_.back();
+						streamPlayers_.pop_back();
+						break;
+					}
+				}
+				streamPlayersMutex_.Unlock();
+				// The streaming thread locks the player before releasing the array, so waiting for the player is enough
+				// if it's being updated right now, then the player can be safely destroyed by the caller
+				streamPlayer->lockStream();
+				streamPlayer->unlockStream();
+			}
+		}
+#endif
+
 		sourcePool_.push_back(player->sourceId_);
 		player->sourceId_ = UnavailableSource;
 
@@ -215,13 +417,22 @@ namespace nCine
 		}
 #endif
 
-		for (auto& player : players_) {
-			player->updateState();
+		updateMixer();
+
+		// Players unregister themselves when they stop, so the array is iterated backwards
+		// The array can shrink by more than one player during an update, so the index is checked again
+		std::size_t i = players_.size();
+		while (i > 0) {
+			i--;
+			if (i < players_.size()) {
+				players_[i]->updateState();
+			}
 		}
 	}
 
 	void ALAudioDevice::updateListener(const Vector3f& position, const Vector3f& velocity)
 	{
+		listenerPos_ = position;
 		alListener3f(AL_POSITION, position.X * LengthToPhysical, position.Y * -LengthToPhysical, position.Z * -LengthToPhysical);
 		alListener3f(AL_VELOCITY, velocity.X * VelocityToPhysical, velocity.Y * -VelocityToPhysical, velocity.Z * -VelocityToPhysical);
 	}
@@ -231,6 +442,208 @@ namespace nCine
 		return nativeFreq_;
 	}
 
+	///////////////////////////////////////////////////////////
+	// PRIVATE FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	float ALAudioDevice::calculateAudibility(const IAudioPlayer* player) const
+	{
+		constexpr float ReferenceDistance = IAudioDevice::ReferenceDistance / IAudioDevice::LengthToPhysical;
+		constexpr float MaxDistance = IAudioDevice::MaxDistance / IAudioDevice::LengthToPhysical;
+
+		Vector3f relativePos = (player->isSourceRelative_ ? player->position_ : player->position_ - listenerPos_);
+		float distance = std::clamp(relativePos.Length(), ReferenceDistance, MaxDistance);
+
+		// Same as AL_LINEAR_DISTANCE_CLAMPED distance model
+		return player->gain_ * (1.0f - (distance - ReferenceDistance) / (MaxDistance - ReferenceDistance));
+	}
+
+	bool ALAudioDevice::stealSource(IAudioPlayer* player, float audibility)
+	{
+		// Only buffer players can lose their source, stream players are usually music
+		IAudioPlayer* victim = nullptr;
+		float victimAudibility = 0.0f;
+		for (IAudioPlayer* otherPlayer : players_) {
+			if (otherPlayer->type() != AudioBufferPlayer::sType()) {
+				continue;
+			}
+
+			float otherAudibility = calculateAudibility(otherPlayer);
+			if (victim == nullptr || otherPlayer->priority_ < victim->priority_ ||
+				(otherPlayer->priority_ == victim->priority_ && otherAudibility < victimAudibility)) {
+				victim = otherPlayer;
+				victimAudibility = otherAudibility;
+			}
+		}
+
+		if (victim == nullptr || victim->priority_ > player->priority_ ||
+			(victim->priority_ == player->priority_ && victimAudibility >= audibility)) {
+			return false;
+		}
+
+		// Stopped player unregisters itself and returns its source to the pool
+		victim->stop();
+		return !sourcePool_.empty();
+	}
+
+	bool ALAudioDevice::canMixPlayer(const IAudioPlayer* player) const
+	{
+		if (mixSourceId_ == UnavailableSource || mixVoices_.size() >= MaxMixVoices || player->type() != AudioBufferPlayer::sType()) {
+			return false;
+		}
+
+		// Only short uncompressed buffers keep their samples in memory
+		const AudioBuffer* audioBuffer = static_cast<const AudioBufferPlayer*>(player)->audioBuffer();
+		return (audioBuffer != nullptr && audioBuffer->mixSamples() != nullptr && audioBuffer->numSamples() > 0);
+	}
+
+	void ALAudioDevice::updateMixer()
+	{
+		if (mixSourceId_ == UnavailableSource) {
+			return;
+		}
+
+		ALint processedCount = 0;
+		alGetSourcei(mixSourceId_, AL_BUFFERS_PROCESSED, &processedCount);
+		if (processedCount > 0) {
+			ALuint processedBuffers[MixBufferCount];
+			alSourceUnqueueBuffers(mixSourceId_, processedCount, processedBuffers);
+			for (ALint i = 0; i < processedCount; i++) {
+				mixFreeBuffers_.push_back(processedBuffers[i]);
+			}
+		}
+
+		// Remaining buffers are left to drain when there is nothing to mix, the source then stops on its own
+		if (mixVoices_.empty()) {
+			return;
+		}
+
+		while (!mixFreeBuffers_.empty()) {
+			ALuint bufferId = mixFreeBuffers_.pop_back_val();
+			mixVoices(MixBufferFrames);
+			alBufferData(bufferId, AL_FORMAT_STEREO16, mixOutput_, sizeof(mixOutput_), nativeFreq_);
+			alSourceQueueBuffers(mixSourceId_, 1, &bufferId);
+		}
+
+		// The source also stops if buffers run out during a long frame, so it has to be restarted
+		ALenum state;
+		alGetSourcei(mixSourceId_, AL_SOURCE_STATE, &state);
+		if (state != AL_PLAYING) {
+			alSourcePlay(mixSourceId_);
+		}
+	}
+
+	void ALAudioDevice::mixVoices(unsigned int frameCount)
+	{
+		constexpr float ReferenceDistance = IAudioDevice::ReferenceDistance / IAudioDevice::LengthToPhysical;
+		constexpr float MinLowPass = 0.05f;
+
+		std::memset(mixAccumulator_, 0, frameCount * 2 * sizeof(float));
+
+		// Voices that reach the end unregister themselves, so the array is iterated backwards
+		for (int i = (int)mixVoices_.size() - 1; i >= 0; i--) {
+			MixVoice& voice = mixVoices_[i];
+			AudioBufferPlayer* player = voice.player;
+			if (player->state_ != IAudioPlayer::PlayerState::Playing) {
+				continue;
+			}
+
+			const AudioBuffer* audioBuffer = player->audioBuffer();
+			const int16_t* samples = audioBuffer->mixSamples();
+			const unsigned long int numSamples = audioBuffer->numSamples();
+			const bool isStereo = (audioBuffer->numChannels() == 2);
+			const float step = player->pitch_ * float(audioBuffer->frequency()) / float(nativeFreq_);
+
+			// Like in OpenAL, only mono sounds are panned, the equal power law keeps the loudness constant
+			const float gain = calculateAudibility(player) / 32768.0f;
+			float gainLeft = gain;
+			float gainRight = gain;
+			if (!isStereo) {
+				Vector3f relativePos = (player->isSourceRelative_ ? player->position_ : player->position_ - listenerPos_);
+				float pan = std::clamp(relativePos.X / std::max(relativePos.Length(), ReferenceDistance), -1.0f, 1.0f);
+				float angle = (pan + 1.0f) * fPiOver4;
+				gainLeft *= std::cos(angle);
+				gainRight *= std::sin(angle);
+			}
+
+			// One-pole filter is only a rough approximation of AL_LOWPASS_GAINHF, but it's enough for these sounds
+			const float lowPass = std::clamp(player->lowPass_, MinLowPass, 1.0f);
+
+			float position = voice.position;
+			bool hasEnded = false;
+			for (unsigned int j = 0; j < frameCount; j++) {
+				unsigned long int index = (unsigned long int)position;
+				unsigned long int nextIndex = index + 1;
+				if (nextIndex >= numSamples) {
+					nextIndex = (player->isLooping_ ? 0 : index);
+				}
+				float frac = position - float(index);
+
+				float left, right;
+				if (isStereo) {
+					left = samples[index * 2] + (samples[nextIndex * 2] - samples[index * 2]) * frac;
+					right = samples[index * 2 + 1] + (samples[nextIndex * 2 + 1] - samples[index * 2 + 1]) * frac;
+				} else {
+					left = samples[index] + (samples[nextIndex] - samples[index]) * frac;
+					right = left;
+				}
+
+				voice.filterLeft += lowPass * (left * gainLeft - voice.filterLeft);
+				voice.filterRight += lowPass * (right * gainRight - voice.filterRight);
+				mixAccumulator_[j * 2] += voice.filterLeft;
+				mixAccumulator_[j * 2 + 1] += voice.filterRight;
+
+				position += step;
+				if (position >= float(numSamples)) {
+					if (!player->isLooping_) {
+						hasEnded = true;
+						break;
+					}
+					position = std::fmod(position, float(numSamples));
+				}
+			}
+			voice.position = position;
+
+			if (hasEnded) {
+				player->state_ = IAudioPlayer::PlayerState::Stopped;
+				unregisterPlayer(player);
+			}
+		}
+
+		for (unsigned int i = 0; i < frameCount * 2; i++) {
+			mixOutput_[i] = int16_t(std::clamp(mixAccumulator_[i] * 32767.0f, -32768.0f, 32767.0f));
+		}
+	}
+
+#if defined(WITH_THREADS)
+	void ALAudioDevice::streamThreadFunction(void* arg)
+	{
+		ALAudioDevice* device = static_cast<ALAudioDevice*>(arg);
+
+		while (!device->streamThreadQuit_) {
+			// Players can be removed by the main thread between two iterations, so some of them can be skipped
+			// or updated twice in a single pass, which doesn't matter with such a short interval
+			unsigned int i = 0;
+			while (true) {
+				device->streamPlayersMutex_.Lock();
+				if (i >= device->streamPlayers_.size()) {
+					device->streamPlayersMutex_.Unlock();
+					break;
+				}
+				AudioStreamPlayer* player = device->streamPlayers_[i++];
+				// Lock the player before releasing the array, so it cannot be unregistered and destroyed in the meantime
+				player->lockStream();
+				device->streamPlayersMutex_.Unlock();
+
+				player->updateStream();
+				player->unlockStream();
+			}
+
+			Timer::sleep(StreamUpdateInterval);
+		}
+	}
+#endif
+
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)
 	void ALAudioDevice::recreateAudioDevice()
 	{
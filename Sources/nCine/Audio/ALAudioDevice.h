@@ -13,10 +13,20 @@
 #include <Containers/SmallVector.h>
 #include <Containers/String.h>
 
+#if defined(WITH_THREADS)
+#	include "../Threading/Thread.h"
+#	include "../Threading/ThreadSync.h"
+#	include <atomic>
+#endif
+
 using namespace Death::Containers;
 
 namespace nCine
 {
+	class AppConfiguration;
+	class AudioBufferPlayer;
+	class AudioStreamPlayer;
+
 	/// It represents the interface to the OpenAL audio device
 	class ALAudioDevice : public IAudioDevice
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)
@@ -24,7 +34,7 @@ namespace nCine
 #endif
 	{
 	public:
-		ALAudioDevice();
+		explicit ALAudioDevice(const AppConfiguration& appCfg);
 		~ALAudioDevice() override;
 
 		inline const char* name() const override {
@@ -37,10 +47,10 @@ namespace nCine
 		void setGain(float gain) override;
 
 		inline unsigned int maxNumPlayers() const override {
-			return MaxSources;
+			return MaxSources + MaxMixVoices;
 		}
 		inline unsigned int numPlayers() const override {
-			return (unsigned int)players_.size();
+			return (unsigned int)(players_.size() + mixVoices_.size());
 		}
 		const IAudioPlayer* player(unsigned int index) const override;
 
@@ -60,6 +70,18 @@ namespace nCine
 
 		int nativeFrequency() override;
 
+	protected:
+		/// Sample rate of the loopback device
+		static const int LoopbackFrequency = 44100;
+
+		/// Creates the device, a loopback device renders the mix on request instead of playing it
+		ALAudioDevice(const AppConfiguration& appCfg, bool isLoopback);
+
+		/// Returns the OpenAL device
+		inline ALCdevice* alcDevice() const {
+			return device_;
+		}
+
 	private:
 		/// Maximum number of OpenAL sources
 #if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_EMSCRIPTEN) || defined(DEATH_TARGET_IOS)
@@ -67,6 +89,25 @@ namespace nCine
 #else
 		static const unsigned int MaxSources = 64;
 #endif
+		/// Maximum number of players that can play the same buffer at once
+		static const unsigned int MaxVoicesPerBuffer = 4;
+		/// Maximum number of players mixed in software when all sources are in use
+		static const unsigned int MaxMixVoices = 64;
+		/// Number of buffers queued on the mixer source
+		static const unsigned int MixBufferCount = 4;
+		/// Number of stereo frames in each mixer buffer
+		static const unsigned int MixBufferFrames = 1024;
+
+		/// Player without an OpenAL source of its own
+		struct MixVoice
+		{
+			AudioBufferPlayer* player;
+			/// Current position in frames of the buffer
+			float position;
+			/// Last output of the low-pass filter for each channel
+			float filterLeft;
+			float filterRight;
+		};
 
 		/// The OpenAL device
 		ALCdevice* device_;
@@ -80,12 +121,52 @@ namespace nCine
 		SmallVector<ALuint, MaxSources> sourcePool_;
 		/// The array of currently active audio players
 		SmallVector<IAudioPlayer*, MaxSources> players_;
+		/// Source that plays players mixed in software, `UnavailableSource` if the mixer is disabled
+		ALuint mixSourceId_;
+		/// Buffers that are streamed to the mixer source
+		ALuint mixBuffers_[MixBufferCount];
+		/// Mixer buffers that are not queued at the moment
+		SmallVector<ALuint, MixBufferCount> mixFreeBuffers_;
+		/// Players mixed in software
+		SmallVector<MixVoice, MaxMixVoices> mixVoices_;
+		/// Samples of all voices are summed here before they are converted to 16-bit
+		float mixAccumulator_[MixBufferFrames * 2];
+		int16_t mixOutput_[MixBufferFrames * 2];
+		/// Last known listener position, used to estimate audibility of players
+		Vector3f listenerPos_;
 		/// native device frequency
 		int nativeFreq_;
 
 		/// The OpenAL device name string
 		const char* deviceName_;
 
+		/// Returns estimated gain of the player after distance attenuation
+		float calculateAudibility(const IAudioPlayer* player) const;
+		/// Frees a source for the new player by stopping a less important one, returns `false` if there is none
+		bool stealSource(IAudioPlayer* player, float audibility);
+		/// Returns true if the player can be mixed in software when there are no free sources
+		bool canMixPlayer(const IAudioPlayer* player) const;
+		/// Refills processed buffers of the mixer source
+		void updateMixer();
+		/// Mixes all software voices into `mixOutput_`, voices that reach the end are stopped
+		void mixVoices(unsigned int frameCount);
+
+#if defined(WITH_THREADS)
+		/// Interval in seconds between two updates of the streaming thread
+		static constexpr float StreamUpdateInterval = 0.01f;
+
+		/// Worker thread that decodes and queues buffers of stream players
+		Thread streamThread_;
+		/// Protects the array of stream players, it's never held during decoding
+		Mutex streamPlayersMutex_;
+		/// Stream players updated by the streaming thread
+		SmallVector<AudioStreamPlayer*, MaxSources> streamPlayers_;
+		std::atomic<bool> streamThreadQuit_;
+		bool streamThreadRunning_;
+
+		static void streamThreadFunction(void* arg);
+#endif
+
 		/// Deleted copy constructor
 		ALAudioDevice(const ALAudioDevice&) = delete;
 		/// Deleted assignment operator
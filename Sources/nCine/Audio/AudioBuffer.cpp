@@ -4,6 +4,9 @@
 #include "AudioBuffer.h"
 #include "IAudioLoader.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace nCine
 {
 	namespace
@@ -21,6 +24,53 @@ namespace nCine
 			return format;
 		}
 
+		/// Number of samples in each IMA ADPCM block, it's the default block alignment of OpenAL
+		constexpr unsigned int Ima4SamplesPerBlock = 65;
+		/// Size in bytes of each mono IMA ADPCM block, the header contains the first sample and 4 bits are used for each other
+		constexpr unsigned int Ima4BlockSize = 4 + (Ima4SamplesPerBlock - 1) / 2;
+
+		constexpr int Ima4StepSize[89] = {
+			7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107,
+			118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+			1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894,
+			6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+		};
+		constexpr int Ima4IndexAdjust[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+		/// Encodes one block, the step index is carried over from the previous block
+		void encodeIma4Block(const int16_t* samples, unsigned int count, int& index, unsigned char* dst)
+		{
+			int sample = samples[0];
+			dst[0] = (unsigned char)(sample & 0xff);
+			dst[1] = (unsigned char)((sample >> 8) & 0xff);
+			dst[2] = (unsigned char)index;
+			dst[3] = 0;
+			std::memset(dst + 4, 0, Ima4BlockSize - 4);
+
+			for (unsigned int i = 1; i < Ima4SamplesPerBlock; i++) {
+				// The last sample is repeated to pad the final block
+				const int target = samples[i < count ? i : count - 1];
+				const int step = Ima4StepSize[index];
+
+				int diff = target - sample;
+				int nibble = 0;
+				if (diff < 0) {
+					nibble = 8;
+					diff = -diff;
+				}
+				// The decoded difference is `(2 * code + 1) * step / 8`
+				const int code = std::min(4 * diff / step, 7);
+				nibble |= code;
+
+				// Follow the decoder exactly, so the predicted sample doesn't drift
+				const int delta = (2 * code + 1) * step / 8;
+				sample = std::clamp(sample + ((nibble & 8) != 0 ? -delta : delta), -32768, 32767);
+				index = std::clamp(index + Ima4IndexAdjust[code], 0, 88);
+
+				const unsigned int nibbleIndex = i - 1;
+				dst[4 + nibbleIndex / 2] |= (unsigned char)(nibble << ((nibbleIndex & 1) * 4));
+			}
+		}
 	}
 
 	///////////////////////////////////////////////////////////
@@ -29,7 +79,7 @@ namespace nCine
 
 	AudioBuffer::AudioBuffer()
 		: Object(ObjectType::AudioBuffer), bufferId_(0),
-		bytesPerSample_(0), numChannels_(0), frequency_(0), numSamples_(0), duration_(0.0f)
+		bytesPerSample_(0), numChannels_(0), frequency_(0), numSamples_(0), duration_(0.0f), isCompressed_(false)
 	{
 		alGetError();
 		alGenBuffers(1, &bufferId_);
@@ -64,7 +114,8 @@ namespace nCine
 	AudioBuffer::AudioBuffer(AudioBuffer&& other)
 		: Object(std::move(other)), bufferId_(other.bufferId_),
 		bytesPerSample_(other.bytesPerSample_), numChannels_(other.numChannels_),
-		frequency_(other.frequency_), numSamples_(other.numSamples_), duration_(other.duration_)
+		frequency_(other.frequency_), numSamples_(other.numSamples_), duration_(other.duration_), isCompressed_(other.isCompressed_),
+		mixSamples_(std::move(other.mixSamples_))
 	{
 		other.bufferId_ = 0;
 	}
@@ -79,6 +130,8 @@ namespace nCine
 		frequency_ = other.frequency_;
 		numSamples_ = other.numSamples_;
 		duration_ = other.duration_;
+		isCompressed_ = other.isCompressed_;
+		mixSamples_ = std::move(other.mixSamples_);
 
 		other.bufferId_ = 0;
 		return *this;
@@ -120,7 +173,7 @@ namespace nCine
 			return false;
 		}
 
-		const bool samplesHaveLoaded = load(*audioLoader.get());
+		const bool samplesHaveLoaded = load(*audioLoader.get(), false);
 		return samplesHaveLoaded;
 	}
 
@@ -131,7 +184,18 @@ namespace nCine
 			return false;
 		}
 
-		const bool samplesHaveLoaded = load(*audioLoader.get());
+		const bool samplesHaveLoaded = load(*audioLoader.get(), false);
+		return samplesHaveLoaded;
+	}
+
+	bool AudioBuffer::loadFromFileCompressed(const StringView& filename)
+	{
+		std::unique_ptr<IAudioLoader> audioLoader = IAudioLoader::createFromFile(filename);
+		if (!audioLoader->hasLoaded()) {
+			return false;
+		}
+
+		const bool samplesHaveLoaded = load(*audioLoader.get(), true);
 		return samplesHaveLoaded;
 	}
 
@@ -155,15 +219,23 @@ namespace nCine
 
 		numSamples_ = bufferSize / (numChannels_ * bytesPerSample_);
 		duration_ = float(numSamples_) / frequency_;
+		isCompressed_ = false;
+		storeMixSamples(error == AL_NO_ERROR ? bufferPtr : nullptr);
 
 		return (error == AL_NO_ERROR);
 	}
 
+	bool AudioBuffer::isCompressionSupported()
+	{
+		static const bool isSupported = (alIsExtensionPresent("AL_EXT_IMA4") == AL_TRUE);
+		return isSupported;
+	}
+
 	///////////////////////////////////////////////////////////
 	// PRIVATE FUNCTIONS
 	///////////////////////////////////////////////////////////
 
-	bool AudioBuffer::load(IAudioLoader& audioLoader)
+	bool AudioBuffer::load(IAudioLoader& audioLoader, bool compress)
 	{
 		//RETURNF_ASSERT_MSG_X(audioLoader.bytesPerSample() == 1 || audioLoader.bytesPerSample() == 2,
 		//                     "Unsupported number of bytes per sample: %d", audioLoader.bytesPerSample());
@@ -181,6 +253,63 @@ namespace nCine
 		std::unique_ptr<IAudioReader> audioReader = audioLoader.createReader();
 		audioReader->read(buffer.get(), bufferSize);
 
+		if (compress && bytesPerSample_ == 2 && numChannels_ == 1 && isCompressionSupported()) {
+			return loadFromSamplesCompressed(buffer.get(), bufferSize);
+		}
 		return loadFromSamples(buffer.get(), bufferSize);
 	}
+
+	bool AudioBuffer::loadFromSamplesCompressed(const unsigned char* bufferPtr, unsigned long int bufferSize)
+	{
+		const ALenum format = alGetEnumValue("AL_FORMAT_MONO_IMA4");
+		const unsigned int sampleCount = bufferSize / sizeof(int16_t);
+		if (format == 0 || format == -1 || sampleCount == 0) {
+			return loadFromSamples(bufferPtr, bufferSize);
+		}
+
+		// Samples are expected to be in native (little endian) byte order, as returned by audio readers
+		const int16_t* samples = reinterpret_cast<const int16_t*>(bufferPtr);
+		const unsigned int blockCount = (sampleCount + Ima4SamplesPerBlock - 1) / Ima4SamplesPerBlock;
+		const unsigned long int compressedSize = blockCount * Ima4BlockSize;
+		std::unique_ptr<unsigned char[]> compressed = std::make_unique<unsigned char[]>(compressedSize);
+
+		int index = 0;
+		for (unsigned int i = 0; i < blockCount; i++) {
+			const unsigned int offset = i * Ima4SamplesPerBlock;
+			encodeIma4Block(samples + offset, std::min(sampleCount - offset, Ima4SamplesPerBlock), index, compressed.get() + i * Ima4BlockSize);
+		}
+
+		alGetError();
+		alBufferData(bufferId_, format, compressed.get(), (ALsizei)compressedSize, frequency_);
+		const ALenum error = alGetError();
+		if (error != AL_NO_ERROR) {
+			// Fall back to uncompressed samples if the device refuses the format
+			return loadFromSamples(bufferPtr, bufferSize);
+		}
+
+		numSamples_ = sampleCount;
+		duration_ = float(numSamples_) / frequency_;
+		isCompressed_ = true;
+		mixSamples_.reset();
+		return true;
+	}
+
+	void AudioBuffer::storeMixSamples(const unsigned char* bufferPtr)
+	{
+		const unsigned long int sampleCount = numSamples_ * numChannels_;
+		if (bufferPtr == nullptr || sampleCount == 0 || sampleCount > MaxMixSamples || (bytesPerSample_ != 1 && bytesPerSample_ != 2)) {
+			mixSamples_.reset();
+			return;
+		}
+
+		mixSamples_ = std::make_unique<int16_t[]>(sampleCount);
+		if (bytesPerSample_ == 2) {
+			std::memcpy(mixSamples_.get(), bufferPtr, sampleCount * sizeof(int16_t));
+		} else {
+			// 8-bit samples are unsigned with the center at 128
+			for (unsigned long int i = 0; i < sampleCount; i++) {
+				mixSamples_[i] = int16_t((int(bufferPtr[i]) - 128) << 8);
+			}
+		}
+	}
 }
@@ -2,6 +2,9 @@
 
 #include "../Base/Object.h"
 
+#include <cstdint>
+#include <memory>
+
 #include <Containers/StringView.h>
 
 using namespace Death::Containers;
@@ -42,9 +45,15 @@ namespace nCine
 
 		bool loadFromMemory(const unsigned char* bufferPtr, unsigned long int bufferSize);
 		bool loadFromFile(const StringView& filename);
+		/// Loads samples from a file and keeps them compressed as IMA ADPCM if the device supports it
+		/*! \note Only 16-bit mono samples can be compressed, other formats are loaded uncompressed */
+		bool loadFromFileCompressed(const StringView& filename);
 		/// Loads samples in raw PCM format from a memory buffer
 		bool loadFromSamples(const unsigned char* bufferPtr, unsigned long int bufferSize);
 
+		/// Returns true if the OpenAL device can keep samples compressed as IMA ADPCM
+		static bool isCompressionSupported();
+
 		/// Returns the OpenAL buffer id
 		inline unsigned int bufferId() const {
 			return bufferId_;
@@ -77,6 +86,16 @@ namespace nCine
 			return numSamples_ * numChannels_ * bytesPerSample_;
 		}
 
+		/// Returns true if samples are stored compressed as IMA ADPCM
+		inline bool isCompressed() const {
+			return isCompressed_;
+		}
+
+		/// Returns interleaved 16-bit samples kept for software mixing, or `nullptr` if the buffer is too long or compressed
+		inline const int16_t* mixSamples() const {
+			return mixSamples_.get();
+		}
+
 		inline static ObjectType sType() {
 			return ObjectType::AudioBuffer;
 		}
@@ -96,9 +115,20 @@ namespace nCine
 		unsigned long int numSamples_;
 		/// Duration in seconds
 		float duration_;
+		/// Samples are stored compressed as IMA ADPCM
+		bool isCompressed_;
+		/// Host copy of short buffers, used when the device runs out of sources
+		std::unique_ptr<int16_t[]> mixSamples_;
+
+		/// Maximum number of samples (of all channels) that are kept in memory for software mixing
+		static constexpr unsigned long int MaxMixSamples = 4 * 44100;
 
 		/// Loads audio samples based on information from the audio loader and reader
-		bool load(IAudioLoader& audioLoader);
+		bool load(IAudioLoader& audioLoader, bool compress);
+		/// Keeps a 16-bit copy of the samples if they are short enough to be mixed in software
+		void storeMixSamples(const unsigned char* bufferPtr);
+		/// Encodes 16-bit mono PCM samples as IMA ADPCM blocks and uploads them
+		bool loadFromSamplesCompressed(const unsigned char* bufferPtr, unsigned long int bufferSize);
 
 		/// Deleted copy constructor
 		AudioBuffer(const AudioBuffer&) = delete;
@@ -85,10 +85,14 @@ namespace nCine
 
 				const unsigned int source = device.registerPlayer(this);
 				if (source == IAudioDevice::UnavailableSource) {
-					LOGW("No more available audio sources for playing");
 					break;
 				}
 				sourceId_ = source;
+				if (sourceId_ == IAudioDevice::MixedSource) {
+					// The device mixes the player in software, there is no OpenAL source to set up
+					state_ = PlayerState::Playing;
+					break;
+				}
 
 				alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
 				// Setting OpenAL source looping only if not streaming
@@ -109,9 +113,10 @@ namespace nCine
 				break;
 			}
 			case PlayerState::Paused: {
-				updateFilters();
-
-				alSourcePlay(sourceId_);
+				if (sourceId_ != IAudioDevice::MixedSource) {
+					updateFilters();
+					alSourcePlay(sourceId_);
+				}
 				state_ = PlayerState::Playing;
 				break;
 			}
@@ -122,7 +127,9 @@ namespace nCine
 	{
 		switch (state_) {
 			case PlayerState::Playing: {
-				alSourcePause(sourceId_);
+				if (sourceId_ != IAudioDevice::MixedSource) {
+					alSourcePause(sourceId_);
+				}
 				state_ = PlayerState::Paused;
 				break;
 			}
@@ -134,14 +141,16 @@ namespace nCine
 		switch (state_) {
 			case PlayerState::Playing:
 			case PlayerState::Paused: {
-				alSourceStop(sourceId_);
-				// Detach the buffer from source
-				alSourcei(sourceId_, AL_BUFFER, 0);
+				if (sourceId_ != IAudioDevice::MixedSource) {
+					alSourceStop(sourceId_);
+					// Detach the buffer from source
+					alSourcei(sourceId_, AL_BUFFER, 0);
 #if defined(OPENAL_FILTERS_SUPPORTED)
-				if (filterHandle_ != 0) {
-					alSourcei(sourceId_, AL_DIRECT_FILTER, 0);
-				}
+					if (filterHandle_ != 0) {
+						alSourcei(sourceId_, AL_DIRECT_FILTER, 0);
+					}
 #endif
+				}
 				state_ = PlayerState::Stopped;
 				break;
 			}
@@ -153,7 +162,8 @@ namespace nCine
 
 	void AudioBufferPlayer::updateState()
 	{
-		if (state_ == PlayerState::Playing) {
+		// Software mixed players are stopped by the device when they reach the end
+		if (state_ == PlayerState::Playing && sourceId_ != IAudioDevice::MixedSource) {
 			ALenum alState;
 			alGetSourcei(sourceId_, AL_SOURCE_STATE, &alState);
 
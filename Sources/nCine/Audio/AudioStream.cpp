@@ -5,6 +5,7 @@
 #include "IAudioLoader.h"
 #include "IAudioReader.h"
 #include "../ServiceLocator.h"
+#include "../Application.h"
 
 namespace nCine
 {
@@ -16,13 +17,19 @@ namespace nCine
 	AudioStream::AudioStream()
 		: nextAvailableBufferIndex_(0),
 		currentBufferId_(0), bytesPerSample_(0), numChannels_(0), isLooping_(false),
-		frequency_(0), numSamples_(0), duration_(0.0f), buffersIds_(NumBuffers)
+		frequency_(0), numSamples_(0), duration_(0.0f)
 	{
+		// At least two buffers are needed, so one can be refilled while the other one is playing
+		const AppConfiguration& appCfg = theApplication().appConfiguration();
+		numBuffers_ = std::max((int)appCfg.audioStreamBufferCount, 2);
+		bufferSize_ = std::max((int)appCfg.audioStreamBufferSize, 1024);
+		buffersIds_.resize(numBuffers_);
+
 		alGetError();
-		alGenBuffers(NumBuffers, buffersIds_.data());
+		alGenBuffers(numBuffers_, buffersIds_.data());
 		const ALenum error = alGetError();
 		ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
-		memBuffer_ = std::make_unique<char[]>(BufferSize);
+		memBuffer_ = std::make_unique<char[]>(bufferSize_);
 	}
 
 	/*! Private constructor called only by `AudioStreamPlayer`. */
@@ -48,8 +55,8 @@ namespace nCine
 	AudioStream::~AudioStream()
 	{
 		// Don't delete buffers if this is a moved out object
-		if (buffersIds_.size() == NumBuffers) {
-			alDeleteBuffers(NumBuffers, buffersIds_.data());
+		if (!buffersIds_.empty()) {
+			alDeleteBuffers((ALsizei)buffersIds_.size(), buffersIds_.data());
 		}
 	}
 
@@ -64,7 +71,7 @@ namespace nCine
 	unsigned long int AudioStream::numStreamSamples() const
 	{
 		if (numChannels_ * bytesPerSample_ > 0) {
-			return BufferSize / (numChannels_ * bytesPerSample_);
+			return bufferSize_ / (numChannels_ * bytesPerSample_);
 		}
 		return 0UL;
 	}
@@ -92,16 +99,18 @@ namespace nCine
 		}
 
 		// Queueing
-		if (nextAvailableBufferIndex_ < NumBuffers) {
+		if (nextAvailableBufferIndex_ < numBuffers_) {
 			currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
 
-			unsigned long bytes = audioReader_->read(memBuffer_.get(), BufferSize);
+			// Buffer size is clamped to at least 1024 bytes in the constructor, so it's never negative
+			const unsigned long bufferSize = (unsigned long)bufferSize_;
+			unsigned long bytes = audioReader_->read(memBuffer_.get(), bufferSize);
 
 			// EOF reached
-			if (bytes < BufferSize) {
+			if (bytes < bufferSize) {
 				if (looping) {
 					audioReader_->rewind();
-					const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, BufferSize - bytes);
+					const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, bufferSize - bytes);
 					bytes += moreBytes;
 				}
 			}
@@ -123,8 +132,8 @@ namespace nCine
 		ALenum state;
 		alGetSourcei(source, AL_SOURCE_STATE, &state);
 
-		// Handle buffer underrun case
-		if (state != AL_PLAYING) {
+		// Handle buffer underrun case, paused sources and sources that haven't been started yet are left untouched
+		if (state == AL_STOPPED) {
 			ALint numQueuedBuffers = 0;
 			alGetSourcei(source, AL_BUFFERS_QUEUED, &numQueuedBuffers);
 			if (numQueuedBuffers > 0) {
@@ -54,7 +54,11 @@ namespace nCine
 		unsigned long int numStreamSamples() const;
 		/// Returns the size of the streaming buffer in bytes
 		inline int streamBufferSize() const {
-			return BufferSize;
+			return bufferSize_;
+		}
+		/// Returns the number of OpenAL buffers used for streaming
+		inline int numStreamBuffers() const {
+			return numBuffers_;
 		}
 
 		/// Enqueues new buffers and unqueues processed ones
@@ -71,14 +75,14 @@ namespace nCine
 
 	private:
 		/// Number of buffers for streaming
-		static const int NumBuffers = 3;
+		int numBuffers_;
 		/// OpenAL buffer queue for streaming
-		SmallVector<unsigned int, NumBuffers> buffersIds_;
+		SmallVector<unsigned int, 4> buffersIds_;
 		/// Index of the next available OpenAL buffer
 		int nextAvailableBufferIndex_;
 
 		/// Size in bytes of each streaming buffer
-		static const int BufferSize = 16 * 1024;
+		int bufferSize_;
 		/// Memory buffer to feed OpenAL ones
 		std::unique_ptr<char[]> memBuffer_;
 
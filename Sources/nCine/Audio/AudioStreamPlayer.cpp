@@ -11,22 +11,32 @@ namespace nCine
 	///////////////////////////////////////////////////////////
 
 	AudioStreamPlayer::AudioStreamPlayer()
-		: IAudioPlayer(ObjectType::AudioStreamPlayer), audioStream_()
+		: IAudioPlayer(ObjectType::AudioStreamPlayer), audioStream_(), hasStreamEnded_(false)
+#if defined(WITH_THREADS)
+		, isStreamThreaded_(false)
+#endif
 	{
 	}
 
 	AudioStreamPlayer::AudioStreamPlayer(const unsigned char* bufferPtr, unsigned long int bufferSize)
-		: IAudioPlayer(ObjectType::AudioStreamPlayer), audioStream_(bufferPtr, bufferSize)
+		: IAudioPlayer(ObjectType::AudioStreamPlayer), audioStream_(bufferPtr, bufferSize), hasStreamEnded_(false)
+#if defined(WITH_THREADS)
+		, isStreamThreaded_(false)
+#endif
 	{
 	}
 
 	AudioStreamPlayer::AudioStreamPlayer(const StringView& filename)
-		: IAudioPlayer(ObjectType::AudioStreamPlayer), audioStream_(filename)
+		: IAudioPlayer(ObjectType::AudioStreamPlayer), audioStream_(filename), hasStreamEnded_(false)
+#if defined(WITH_THREADS)
+		, isStreamThreaded_(false)
+#endif
 	{
 	}
 
 	AudioStreamPlayer::~AudioStreamPlayer()
 	{
+		// The streaming thread is guaranteed to not access the player anymore after it has been unregistered
 		stop();
 	}
 
@@ -36,20 +46,26 @@ namespace nCine
 
 	bool AudioStreamPlayer::loadFromMemory(const unsigned char* bufferPtr, unsigned long int bufferSize)
 	{
+		lockStream();
 		if (state_ != PlayerState::Stopped) {
 			audioStream_.stop(sourceId_);
 		}
 
-		return audioStream_.loadFromMemory(bufferPtr, bufferSize);
+		const bool hasLoaded = audioStream_.loadFromMemory(bufferPtr, bufferSize);
+		unlockStream();
+		return hasLoaded;
 	}
 
 	bool AudioStreamPlayer::loadFromFile(const char* filename)
 	{
+		lockStream();
 		if (state_ != PlayerState::Stopped) {
 			audioStream_.stop(sourceId_);
 		}
 
-		return audioStream_.loadFromFile(filename);
+		const bool hasLoaded = audioStream_.loadFromFile(filename);
+		unlockStream();
+		return hasLoaded;
 	}
 
 	void AudioStreamPlayer::play()
@@ -59,12 +75,15 @@ namespace nCine
 		switch (state_) {
 			case PlayerState::Initial:
 			case PlayerState::Stopped: {
+				// The streaming thread doesn't touch the player until its state is changed to playing
 				const unsigned int source = device.registerPlayer(this);
 				if (source == IAudioDevice::UnavailableSource) {
-					LOGW("No more available audio sources for playing");
 					break;
 				}
+
+				lockStream();
 				sourceId_ = source;
+				hasStreamEnded_ = false;
 
 				// Streams looping is not handled at enqueued buffer level
 				alSourcei(sourceId_, AL_LOOPING, AL_FALSE);
@@ -81,13 +100,16 @@ namespace nCine
 
 				alSourcePlay(sourceId_);
 				state_ = PlayerState::Playing;
+				unlockStream();
 				break;
 			}
 			case PlayerState::Paused: {
+				lockStream();
 				updateFilters();
 
 				alSourcePlay(sourceId_);
 				state_ = PlayerState::Playing;
+				unlockStream();
 				break;
 			}
 		}
@@ -97,8 +119,10 @@ namespace nCine
 	{
 		switch (state_) {
 			case PlayerState::Playing: {
+				lockStream();
 				alSourcePause(sourceId_);
 				state_ = PlayerState::Paused;
+				unlockStream();
 				break;
 			}
 		}
@@ -109,6 +133,7 @@ namespace nCine
 		switch (state_) {
 			case PlayerState::Playing:
 			case PlayerState::Paused: {
+				lockStream();
 				// Stop the source then unqueue every buffer
 				audioStream_.stop(sourceId_);
 				// Detach the buffer from source
@@ -119,38 +144,73 @@ namespace nCine
 				}
 #endif
 				state_ = PlayerState::Stopped;
+				unlockStream();
 				break;
 			}
 		}
 
+		// The stream mutex must not be locked here, the device may wait for the streaming thread to release the player
 		IAudioDevice& device = theServiceLocator().audioDevice();
 		device.unregisterPlayer(this);
 	}
 
 	void AudioStreamPlayer::setLooping(bool isLooping)
 	{
+		lockStream();
 		IAudioPlayer::setLooping(isLooping);
 
 		audioStream_.setLooping(isLooping);
+		unlockStream();
 	}
 
 	void AudioStreamPlayer::updateState()
 	{
-		if (state_ == PlayerState::Playing) {
-			const bool shouldStillPlay = audioStream_.enqueue(sourceId_, isLooping_);
-			if (!shouldStillPlay) {
-				// Detach the buffer from source
-				alSourcei(sourceId_, AL_BUFFER, 0);
-#if defined(OPENAL_FILTERS_SUPPORTED)
-				if (filterHandle_ != 0) {
-					alSourcei(sourceId_, AL_DIRECT_FILTER, 0);
-				}
+		if (state_ != PlayerState::Playing) {
+			return;
+		}
+
+#if defined(WITH_THREADS)
+		if (isStreamThreaded_) {
+			// Buffers are queued by the streaming thread, only the end of the stream is handled here, so the mutex
+			// is not locked until then to avoid waiting for the decoding, the streaming thread stops touching the stream after the end
+			if (!hasStreamEnded_) {
+				return;
+			}
+			lockStream();
+		} else {
+			lockStream();
+			hasStreamEnded_ = !audioStream_.enqueue(sourceId_, isLooping_);
+		}
+#else
+		hasStreamEnded_ = !audioStream_.enqueue(sourceId_, isLooping_);
 #endif
-				state_ = PlayerState::Stopped;
 
-				IAudioDevice& device = theServiceLocator().audioDevice();
-				device.unregisterPlayer(this);
+		const bool shouldUnregister = hasStreamEnded_;
+		if (hasStreamEnded_) {
+			// Detach the buffer from source
+			alSourcei(sourceId_, AL_BUFFER, 0);
+#if defined(OPENAL_FILTERS_SUPPORTED)
+			if (filterHandle_ != 0) {
+				alSourcei(sourceId_, AL_DIRECT_FILTER, 0);
 			}
+#endif
+			state_ = PlayerState::Stopped;
+		}
+		unlockStream();
+
+		if (shouldUnregister) {
+			IAudioDevice& device = theServiceLocator().audioDevice();
+			device.unregisterPlayer(this);
+		}
+	}
+
+#if defined(WITH_THREADS)
+	void AudioStreamPlayer::updateStream()
+	{
+		// The stream mutex is already locked by the streaming thread
+		if (state_ == PlayerState::Playing && !hasStreamEnded_) {
+			hasStreamEnded_ = !audioStream_.enqueue(sourceId_, isLooping_);
 		}
 	}
+#endif
 }
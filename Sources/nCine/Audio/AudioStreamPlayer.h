@@ -3,6 +3,11 @@
 #include "IAudioPlayer.h"
 #include "AudioStream.h"
 
+#if defined(WITH_THREADS)
+#	include "../Threading/ThreadSync.h"
+#	include <atomic>
+#endif
+
 namespace nCine
 {
 	/// Audio stream player class
@@ -17,10 +22,12 @@ namespace nCine
 		explicit AudioStreamPlayer(const StringView& filename);
 		~AudioStreamPlayer() override;
 
+#if !defined(WITH_THREADS)
 		/// Default move constructor
 		AudioStreamPlayer(AudioStreamPlayer&&) = default;
 		/// Default move assignment operator
 		AudioStreamPlayer& operator=(AudioStreamPlayer&&) = default;
+#endif
 
 		bool loadFromMemory(const unsigned char* bufferPtr, unsigned long int bufferSize);
 		bool loadFromFile(const char* filename);
@@ -64,6 +71,10 @@ namespace nCine
 
 		/// Updates the player state and the stream buffer queue
 		void updateState() override;
+#if defined(WITH_THREADS)
+		/// Updates the stream buffer queue, called by the streaming thread of the audio device with the stream mutex locked
+		void updateStream();
+#endif
 
 		inline static ObjectType sType() {
 			return ObjectType::AudioStreamPlayer;
@@ -72,10 +83,35 @@ namespace nCine
 	private:
 		AudioStream audioStream_;
 
+#if defined(WITH_THREADS)
+		/// The flag is `true` when the stream has been entirely decoded and played, it's polled by the main thread without locking
+		std::atomic<bool> hasStreamEnded_;
+		/// The flag is `true` if the buffer queue is updated by the streaming thread of the audio device
+		bool isStreamThreaded_;
+		/// Protects the stream and the player state from concurrent access by the streaming thread
+		Mutex streamMutex_;
+#else
+		/// The flag is `true` when the stream has been entirely decoded and played
+		bool hasStreamEnded_;
+#endif
+
+		inline void lockStream() {
+#if defined(WITH_THREADS)
+			streamMutex_.Lock();
+#endif
+		}
+		inline void unlockStream() {
+#if defined(WITH_THREADS)
+			streamMutex_.Unlock();
+#endif
+		}
+
 		/// Deleted copy constructor
 		AudioStreamPlayer(const AudioStreamPlayer&) = delete;
 		/// Deleted assignment operator
 		AudioStreamPlayer& operator=(const AudioStreamPlayer&) = delete;
+
+		friend class ALAudioDevice;
 	};
 
 }
@@ -0,0 +1,117 @@
+#include "CaptureAudioDevice.h"
+
+#if defined(ALC_SOFT_loopback)
+
+#include "../Application.h"
+#include "../Base/FrameTimer.h"
+#include "../IO/FileSystem.h"
+
+#include <algorithm>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	CaptureAudioDevice::CaptureAudioDevice(const AppConfiguration& appCfg, const StringView& path)
+		: ALAudioDevice(appCfg, true), alcRenderSamplesSOFT_(nullptr), pendingFrames_(0.0), numRenderedFrames_(0), renderTime_(0.0f)
+	{
+		if (alcDevice() == nullptr) {
+			return;
+		}
+
+		alcRenderSamplesSOFT_ = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(alcDevice(), "alcRenderSamplesSOFT");
+		RETURN_ASSERT_MSG(alcRenderSamplesSOFT_ != nullptr, "alcRenderSamplesSOFT() is not available");
+
+		samples_ = std::make_unique<int16_t[]>(static_cast<size_t>(LoopbackFrequency * MaxRenderInterval) * NumChannels + NumChannels);
+
+		if (!path.empty()) {
+			fileHandle_ = fs::Open(path, FileAccessMode::Write);
+			if (fileHandle_->IsOpened()) {
+				// Sizes are written again when the file is closed
+				writeWavHeader(0);
+				LOGI_X("Audio output is captured to \"%s\"", String::nullTerminatedView(path).data());
+			} else {
+				LOGE_X("Cannot open \"%s\" for audio capture", String::nullTerminatedView(path).data());
+				fileHandle_ = nullptr;
+			}
+		} else {
+			LOGI("Audio output is captured and discarded");
+		}
+	}
+
+	CaptureAudioDevice::~CaptureAudioDevice()
+	{
+		if (fileHandle_ != nullptr) {
+			const uint32_t dataSize = static_cast<uint32_t>(std::min<uint64_t>(numRenderedFrames_ * NumChannels * sizeof(int16_t), UINT32_MAX - 36));
+			fileHandle_->Seek(0, SeekOrigin::Begin);
+			writeWavHeader(dataSize);
+			fileHandle_->Close();
+		}
+
+		const float capturedSeconds = static_cast<float>(numRenderedFrames_) / LoopbackFrequency;
+		LOGI_X("Captured %.2f s of audio in %.2f ms (%.2f ms per second of audio)", capturedSeconds, renderTime_ * 1000.0f,
+			capturedSeconds > 0.0f ? renderTime_ * 1000.0f / capturedSeconds : 0.0f);
+	}
+
+	///////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void CaptureAudioDevice::updatePlayers()
+	{
+		ALAudioDevice::updatePlayers();
+
+		if (alcRenderSamplesSOFT_ == nullptr) {
+			return;
+		}
+
+		// Render the game time of the last frame instead of the wall time, so the output is independent of the real frame rate
+		const float interval = theApplication().timeMult() * FrameTimer::SecondsPerFrame;
+		pendingFrames_ += static_cast<double>(interval) * LoopbackFrequency;
+
+		int numFrames = static_cast<int>(pendingFrames_);
+		pendingFrames_ -= numFrames;
+
+		const int maxChunkFrames = static_cast<int>(LoopbackFrequency * MaxRenderInterval);
+		while (numFrames > 0) {
+			const int chunkFrames = std::min(numFrames, maxChunkFrames);
+
+			const TimeStamp renderStartTime = TimeStamp::now();
+			alcRenderSamplesSOFT_(alcDevice(), samples_.get(), chunkFrames);
+			renderTime_ += renderStartTime.secondsSince();
+			numRenderedFrames_ += chunkFrames;
+
+			if (fileHandle_ != nullptr) {
+				fileHandle_->Write(samples_.get(), static_cast<uint32_t>(chunkFrames * NumChannels * sizeof(int16_t)));
+			}
+			numFrames -= chunkFrames;
+		}
+	}
+
+	///////////////////////////////////////////////////////////
+	// PRIVATE FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void CaptureAudioDevice::writeWavHeader(uint32_t dataSize)
+	{
+		constexpr uint16_t BitsPerSample = 16;
+		constexpr uint16_t BlockAlign = NumChannels * BitsPerSample / 8;
+
+		fileHandle_->Write("RIFF", 4);
+		fileHandle_->WriteValue<uint32_t>(36 + dataSize);
+		fileHandle_->Write("WAVEfmt ", 8);
+		fileHandle_->WriteValue<uint32_t>(16);
+		fileHandle_->WriteValue<uint16_t>(1);	// PCM
+		fileHandle_->WriteValue<uint16_t>(NumChannels);
+		fileHandle_->WriteValue<uint32_t>(LoopbackFrequency);
+		fileHandle_->WriteValue<uint32_t>(LoopbackFrequency * BlockAlign);
+		fileHandle_->WriteValue<uint16_t>(BlockAlign);
+		fileHandle_->WriteValue<uint16_t>(BitsPerSample);
+		fileHandle_->Write("data", 4);
+		fileHandle_->WriteValue<uint32_t>(dataSize);
+	}
+}
+
+#endif
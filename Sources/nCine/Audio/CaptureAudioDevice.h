@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ALAudioDevice.h"
+
+#if defined(ALC_SOFT_loopback)
+
+#include "../Base/TimeStamp.h"
+#include "../IO/IFileStream.h"
+
+#include <memory>
+
+namespace nCine
+{
+	/// Audio device that renders the mix offline instead of playing it
+	/*! The mix is rendered by OpenAL once per frame for the game time of the frame, it's written to a WAV file or discarded if no path is specified.
+	 *  It allows to measure the cost of audio processing and to check the audio output on machines without sound hardware. */
+	class CaptureAudioDevice : public ALAudioDevice
+	{
+	public:
+		CaptureAudioDevice(const AppConfiguration& appCfg, const StringView& path);
+		~CaptureAudioDevice() override;
+
+		void updatePlayers() override;
+
+		/// Returns the number of rendered sample frames
+		inline uint64_t numRenderedFrames() const {
+			return numRenderedFrames_;
+		}
+		/// Returns the total time in seconds spent by rendering
+		inline float renderTime() const {
+			return renderTime_;
+		}
+
+	private:
+		/// Number of output channels
+		static const int NumChannels = 2;
+		/// Maximum time in seconds rendered by one call, longer frames are rendered in more chunks
+		static constexpr float MaxRenderInterval = 0.25f;
+
+		LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT_;
+		std::unique_ptr<IFileStream> fileHandle_;
+		std::unique_ptr<int16_t[]> samples_;
+		double pendingFrames_;
+		uint64_t numRenderedFrames_;
+		float renderTime_;
+
+		void writeWavHeader(uint32_t dataSize);
+
+		/// Deleted copy constructor
+		CaptureAudioDevice(const CaptureAudioDevice&) = delete;
+		/// Deleted assignment operator
+		CaptureAudioDevice& operator=(const CaptureAudioDevice&) = delete;
+	};
+}
+
+#endif
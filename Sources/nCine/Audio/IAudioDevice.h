@@ -12,6 +12,8 @@ namespace nCine
 	{
 	public:
 		static constexpr unsigned int UnavailableSource = ~0U;
+		/// Returned by `registerPlayer()` when the player has no OpenAL source of its own and it's mixed in software instead
+		static constexpr unsigned int MixedSource = ~1U;
 
 		// TODO: Revise these constants
 		static constexpr float LengthToPhysical = 0.0000000005f;
@@ -13,7 +13,7 @@ namespace nCine {
 
 	IAudioPlayer::IAudioPlayer(ObjectType type)
 		: Object(type), sourceId_(IAudioDevice::UnavailableSource),
-		state_(PlayerState::Stopped), isLooping_(false), isSourceRelative_(false),
+		state_(PlayerState::Stopped), isLooping_(false), isSourceRelative_(false), priority_(Priority::Normal),
 		gain_(1.0f), pitch_(1.0f), lowPass_(1.0f), position_(0.0f, 0.0f, 0.0f),
 		filterHandle_(0)
 	{
@@ -36,13 +36,17 @@ namespace nCine {
 	int IAudioPlayer::sampleOffset() const
 	{
 		int byteOffset = 0;
-		alGetSourcei(sourceId_, AL_SAMPLE_OFFSET, &byteOffset);
+		if (sourceId_ != IAudioDevice::MixedSource) {
+			alGetSourcei(sourceId_, AL_SAMPLE_OFFSET, &byteOffset);
+		}
 		return byteOffset;
 	}
 
 	void IAudioPlayer::setSampleOffset(int byteOffset)
 	{
-		alSourcei(sourceId_, AL_SAMPLE_OFFSET, byteOffset);
+		if (sourceId_ != IAudioDevice::MixedSource) {
+			alSourcei(sourceId_, AL_SAMPLE_OFFSET, byteOffset);
+		}
 	}
 
 	/*! The change is applied to the OpenAL source only when playing. */
@@ -50,7 +54,7 @@ namespace nCine {
 	{
 		if (isSourceRelative_ != isSourceRelative) {
 			isSourceRelative_ = isSourceRelative;
-			if (state_ == PlayerState::Playing) {
+			if (state_ == PlayerState::Playing && sourceId_ != IAudioDevice::MixedSource) {
 				alSourcei(sourceId_, AL_SOURCE_RELATIVE, isSourceRelative_ ? AL_TRUE : AL_FALSE);
 			}
 		}
@@ -60,7 +64,7 @@ namespace nCine {
 	void IAudioPlayer::setGain(float gain)
 	{
 		gain_ = gain;
-		if (state_ == PlayerState::Playing) {
+		if (state_ == PlayerState::Playing && sourceId_ != IAudioDevice::MixedSource) {
 			alSourcef(sourceId_, AL_GAIN, gain_);
 		}
 	}
@@ -69,7 +73,7 @@ namespace nCine {
 	void IAudioPlayer::setPitch(float pitch)
 	{
 		pitch_ = pitch;
-		if (state_ == PlayerState::Playing) {
+		if (state_ == PlayerState::Playing && sourceId_ != IAudioDevice::MixedSource) {
 			alSourcef(sourceId_, AL_PITCH, pitch_);
 		}
 	}
@@ -88,7 +92,7 @@ namespace nCine {
 	void IAudioPlayer::setPosition(const Vector3f& position)
 	{
 		position_ = position;
-		if (state_ == PlayerState::Playing) {
+		if (state_ == PlayerState::Playing && sourceId_ != IAudioDevice::MixedSource) {
 			alSource3f(sourceId_, AL_POSITION, position.X * IAudioDevice::LengthToPhysical, position.Y * -IAudioDevice::LengthToPhysical, position.Z * -IAudioDevice::LengthToPhysical);
 		}
 	}
@@ -96,6 +100,11 @@ namespace nCine {
 	void IAudioPlayer::updateFilters()
 	{
 #if defined(OPENAL_FILTERS_SUPPORTED)
+		if (sourceId_ == IAudioDevice::MixedSource) {
+			// Software mixer applies its own filter
+			return;
+		}
+
 		if (lowPass_ < 1.0f) {
 			if (filterHandle_ == 0) {
 				alGenFilters(1, &filterHandle_);
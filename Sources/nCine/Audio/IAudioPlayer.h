@@ -17,6 +17,14 @@ namespace nCine
 			Stopped
 		};
 
+		/// Player priority, it decides which player loses its source when all of them are in use
+		enum class Priority : uint8_t {
+			Low = 0,
+			Normal,
+			High,
+			Critical
+		};
+
 		IAudioPlayer(ObjectType type);
 		~IAudioPlayer() override;
 
@@ -116,6 +124,15 @@ namespace nCine
 		/// Sets player position value through vector
 		void setPosition(const Vector3f& position);
 
+		/// Returns player priority
+		inline Priority priority() const {
+			return priority_;
+		}
+		/// Sets player priority, it's used only when the player starts to play
+		inline void setPriority(Priority priority) {
+			priority_ = priority;
+		}
+
 	protected:
 		/// The OpenAL source id
 		unsigned int sourceId_;
@@ -125,6 +142,8 @@ namespace nCine
 		bool isLooping_;
 		/// Source relative flag
 		bool isSourceRelative_;
+		/// Player priority
+		Priority priority_;
 		/// Player gain value
 		float gain_;
 		/// Player pitch value
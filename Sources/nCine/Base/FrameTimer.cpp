@@ -14,7 +14,7 @@ namespace nCine
 	FrameTimer::FrameTimer(float logInterval, float avgInterval)
 		: logInterval_(logInterval), avgInterval_(avgInterval), lastAvgUpdate_(TimeStamp::now()),
 		totNumFrames_(0L), avgNumFrames_(0L), logNumFrames_(0L), fps_(0.0f),
-		timeMult_(1.0f), timeMultPrev_(1.0f)
+		timeMult_(1.0f), timeMultPrev_(1.0f), isFixedStep_(false)
 	{
 	}
 
@@ -33,10 +33,15 @@ namespace nCine
 		avgNumFrames_++;
 		logNumFrames_++;
 
-		// Smooth out time multiplier using last 2 frames to prevent microstuttering
-		float timeMultPrev = timeMult_;
-		timeMult_ = (timeMultPrev_ + timeMultPrev_ + timeMult_ + (std::min(frameInterval_, SecondsPerFrame * 2) / SecondsPerFrame)) * 0.25f;
-		timeMultPrev_ = timeMultPrev;
+		if (isFixedStep_) {
+			timeMult_ = 1.0f;
+			timeMultPrev_ = 1.0f;
+		} else {
+			// Smooth out time multiplier using last 2 frames to prevent microstuttering
+			float timeMultPrev = timeMult_;
+			timeMult_ = (timeMultPrev_ + timeMultPrev_ + timeMult_ + (std::min(frameInterval_, SecondsPerFrame * 2) / SecondsPerFrame)) * 0.25f;
+			timeMultPrev_ = timeMultPrev;
+		}
 
 		// Update the FPS average calculation every `avgInterval_` seconds
 		const float secsSinceLastAvgUpdate = (frameStart_ - lastAvgUpdate_).seconds();
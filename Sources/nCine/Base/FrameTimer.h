@@ -45,6 +45,15 @@ namespace nCine
 			return timeMult_;
 		}
 
+		/// Returns `true` if every frame advances by exactly the desired frame time
+		inline bool isFixedStep() const {
+			return isFixedStep_;
+		}
+		/// Sets whether every frame advances by exactly the desired frame time regardless of the real elapsed time
+		inline void setFixedStep(bool value) {
+			isFixedStep_ = value;
+		}
+
 	private:
 		/// Number of seconds between two log events (user defined)
 		float logInterval_;
@@ -76,6 +85,8 @@ namespace nCine
 		/// Factor that represents how long the last frame took relative to the desired frame time
 		float timeMult_;
 		float timeMultPrev_;
+		/// Whether the time multiplier is always one
+		bool isFixedStep_;
 	};
 
 }
@@ -51,10 +51,10 @@ namespace nCine {
 	void Timer::sleep(float seconds)
 	{
 #if defined(DEATH_TARGET_WINDOWS)
-		const unsigned int milliseconds = static_cast<unsigned int>(seconds) * 1000;
+		const unsigned int milliseconds = static_cast<unsigned int>(seconds * 1000);
 		::SleepEx(milliseconds, FALSE);
 #else
-		const unsigned int microseconds = static_cast<unsigned int>(seconds) * 1000000;
+		const unsigned int microseconds = static_cast<unsigned int>(seconds * 1000000);
 		usleep(microseconds);
 #endif
 	}
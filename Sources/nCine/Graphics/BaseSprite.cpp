@@ -10,7 +10,7 @@ namespace nCine {
 
 	BaseSprite::BaseSprite(SceneNode* parent, Texture* texture, float xx, float yy)
 		: DrawableNode(parent, xx, yy), texture_(texture), texRect_(0, 0, 0, 0),
-		flippedX_(false), flippedY_(false), instanceBlock_(nullptr)
+		flippedX_(false), flippedY_(false)
 	{
 		renderCommand_.material().setBlendingEnabled(true);
 	}
@@ -100,7 +100,7 @@ namespace nCine {
 
 	BaseSprite::BaseSprite(const BaseSprite& other)
 		: DrawableNode(other), texture_(other.texture_), texRect_(other.texRect_),
-		flippedX_(other.flippedX_), flippedY_(other.flippedY_), instanceBlock_(nullptr)
+		flippedX_(other.flippedX_), flippedY_(other.flippedY_)
 	{
 	}
 
@@ -111,7 +111,6 @@ namespace nCine {
 	void BaseSprite::shaderHasChanged()
 	{
 		renderCommand_.material().reserveUniformsDataMemory();
-		instanceBlock_ = renderCommand_.material().uniformBlock(Material::InstanceBlockName);
 		GLUniformCache* textureUniform = renderCommand_.material().uniform(Material::TextureUniformName);
 		if (textureUniform && textureUniform->intValue(0) != 0) {
 			textureUniform->setIntValue(0); // GL_TEXTURE0
@@ -132,13 +131,13 @@ namespace nCine {
 			dirtyBits_.reset(DirtyBitPositions::TransformationBit);
 		}
 		if (dirtyBits_.test(DirtyBitPositions::ColorBit)) {
-			GLUniformCache* colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
+			GLUniformCache* colorUniform = renderCommand_.material().colorUniform();
 			if (colorUniform)
 				colorUniform->setFloatVector(absColor().Data());
 			dirtyBits_.reset(DirtyBitPositions::ColorBit);
 		}
 		if (dirtyBits_.test(DirtyBitPositions::SizeBit)) {
-			GLUniformCache* spriteSizeUniform = instanceBlock_->uniform(Material::SpriteSizeUniformName);
+			GLUniformCache* spriteSizeUniform = renderCommand_.material().spriteSizeUniform();
 			if (spriteSizeUniform)
 				spriteSizeUniform->setFloatValue(width_, height_);
 			dirtyBits_.reset(DirtyBitPositions::SizeBit);
@@ -148,7 +147,7 @@ namespace nCine {
 			if (texture_) {
 				renderCommand_.material().setTexture(*texture_);
 
-				GLUniformCache* texRectUniform = instanceBlock_->uniform(Material::TexRectUniformName);
+				GLUniformCache* texRectUniform = renderCommand_.material().texRectUniform();
 				if (texRectUniform) {
 					const Vector2i texSize = texture_->size();
 					const float texScaleX = texRect_.W / float(texSize.X);
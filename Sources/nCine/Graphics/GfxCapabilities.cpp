@@ -102,12 +102,14 @@ namespace nCine
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 		const char* extensionNames[(int)GLExtensions::Count] = {
 			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_EXT_texture_compression_s3tc", "GL_OES_compressed_ETC1_RGB8_texture",
-			"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr"
+			"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr",
+			"GL_ARB_buffer_storage"
 		};
 #else
 		const char* extensionNames[(int)GLExtensions::Count] = {
 			"GL_KHR_debug", "GL_ARB_texture_storage", "WEBGL_compressed_texture_s3tc", "WEBGL_compressed_texture_etc1",
-			"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc"
+			"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc",
+			"GL_ARB_buffer_storage"
 		};
 #endif
 
@@ -168,6 +170,7 @@ namespace nCine
 		LOGI_X("GL_AMD_compressed_ATC_texture: %d", glExtensions_[(int)GLExtensions::AMD_COMPRESSED_ATC_TEXTURE]);
 		LOGI_X("GL_IMG_texture_compression_pvrtc: %d", glExtensions_[(int)GLExtensions::IMG_TEXTURE_COMPRESSION_PVRTC]);
 		LOGI_X("GL_KHR_texture_compression_astc_ldr: %d", glExtensions_[(int)GLExtensions::KHR_TEXTURE_COMPRESSION_ASTC_LDR]);
+		LOGI_X("GL_ARB_buffer_storage: %d", glExtensions_[(int)GLExtensions::ARB_BUFFER_STORAGE]);
 		//LOGI("--- OpenGL device capabilities ---");
 		LOGI("---");
 	}
@@ -49,6 +49,7 @@ namespace nCine
 			AMD_COMPRESSED_ATC_TEXTURE,
 			IMG_TEXTURE_COMPRESSION_PVRTC,
 			KHR_TEXTURE_COMPRESSION_ASTC_LDR,
+			ARB_BUFFER_STORAGE,
 
 			Count
 		};
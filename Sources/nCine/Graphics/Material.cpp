@@ -6,6 +6,7 @@
 #include "Texture.h"
 
 #include <cstddef> // for offsetof()
+#include <cstring> // for memset()
 
 namespace nCine
 {
@@ -20,7 +21,8 @@ namespace nCine
 
 	Material::Material(GLShaderProgram* program, GLTexture* texture)
 		: isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-		shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0)
+		shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program),
+		instanceBlock_(nullptr), modelMatrixUniform_(nullptr), colorUniform_(nullptr), texRectUniform_(nullptr), spriteSizeUniform_(nullptr), sortKey_(0), sortKeyDirty_(true), uniformsHostBufferSize_(0)
 	{
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
 			textures_[i] = nullptr;
@@ -30,14 +32,50 @@ namespace nCine
 			setShaderProgram(program);
 	}
 
+	Material::Material(Material&& other) noexcept
+		: isBlendingEnabled_(other.isBlendingEnabled_), srcBlendingFactor_(other.srcBlendingFactor_), destBlendingFactor_(other.destBlendingFactor_),
+		shaderProgramType_(other.shaderProgramType_), shaderProgram_(other.shaderProgram_),
+		shaderUniforms_(std::move(other.shaderUniforms_)), shaderUniformBlocks_(std::move(other.shaderUniformBlocks_)),
+		sortKey_(other.sortKey_), sortKeyDirty_(other.sortKeyDirty_), uniformsHostBufferSize_(other.uniformsHostBufferSize_),
+		uniformsHostBuffer_(std::move(other.uniformsHostBuffer_))
+	{
+		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
+			textures_[i] = other.textures_[i];
+
+		resolveInstanceUniforms();
+	}
+
+	Material& Material::operator=(Material&& other) noexcept
+	{
+		isBlendingEnabled_ = other.isBlendingEnabled_;
+		srcBlendingFactor_ = other.srcBlendingFactor_;
+		destBlendingFactor_ = other.destBlendingFactor_;
+		shaderProgramType_ = other.shaderProgramType_;
+		shaderProgram_ = other.shaderProgram_;
+		shaderUniforms_ = std::move(other.shaderUniforms_);
+		shaderUniformBlocks_ = std::move(other.shaderUniformBlocks_);
+		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
+			textures_[i] = other.textures_[i];
+		sortKey_ = other.sortKey_;
+		sortKeyDirty_ = other.sortKeyDirty_;
+		uniformsHostBufferSize_ = other.uniformsHostBufferSize_;
+		uniformsHostBuffer_ = std::move(other.uniformsHostBuffer_);
+
+		resolveInstanceUniforms();
+		return *this;
+	}
+
 	///////////////////////////////////////////////////////////
 	// PUBLIC FUNCTIONS
 	///////////////////////////////////////////////////////////
 
 	void Material::setBlendingFactors(GLenum srcBlendingFactor, GLenum destBlendingFactor)
 	{
-		srcBlendingFactor_ = srcBlendingFactor;
-		destBlendingFactor_ = destBlendingFactor;
+		if (srcBlendingFactor_ != srcBlendingFactor || destBlendingFactor_ != destBlendingFactor) {
+			srcBlendingFactor_ = srcBlendingFactor;
+			destBlendingFactor_ = destBlendingFactor;
+			sortKeyDirty_ = true;
+		}
 	}
 
 	bool Material::setShaderProgramType(ShaderProgramType shaderProgramType)
@@ -59,9 +97,11 @@ namespace nCine
 
 		shaderProgramType_ = ShaderProgramType::CUSTOM;
 		shaderProgram_ = program;
+		sortKeyDirty_ = true;
 		// The camera uniforms are handled separately as they have a different update frequency
 		shaderUniforms_.setProgram(shaderProgram_, nullptr, ProjectionViewMatrixExcludeString);
 		shaderUniformBlocks_.setProgram(shaderProgram_);
+		resolveInstanceUniforms();
 
 		RenderResources::setDefaultAttributesParameters(*shaderProgram_);
 	}
@@ -120,7 +160,10 @@ namespace nCine
 	{
 		bool result = false;
 		if (unit < GLTexture::MaxTextureUnits) {
-			textures_[unit] = texture;
+			if (textures_[unit] != texture) {
+				textures_[unit] = texture;
+				sortKeyDirty_ = true;
+			}
 			result = true;
 		}
 		return result;
@@ -156,6 +199,23 @@ namespace nCine
 		shaderProgram_->defineVertexFormat(vbo, ibo, vboOffset);
 	}
 
+	void Material::resolveInstanceUniforms()
+	{
+		// Uniform caches are owned by the hashmaps that are refilled only when the shader program changes
+		instanceBlock_ = shaderUniformBlocks_.uniformBlock(InstanceBlockName);
+		if (instanceBlock_ != nullptr) {
+			modelMatrixUniform_ = instanceBlock_->uniform(ModelMatrixUniformName);
+			colorUniform_ = instanceBlock_->uniform(ColorUniformName);
+			texRectUniform_ = instanceBlock_->uniform(TexRectUniformName);
+			spriteSizeUniform_ = instanceBlock_->uniform(SpriteSizeUniformName);
+		} else {
+			modelMatrixUniform_ = shaderUniforms_.uniform(ModelMatrixUniformName);
+			colorUniform_ = nullptr;
+			texRectUniform_ = nullptr;
+			spriteSizeUniform_ = nullptr;
+		}
+	}
+
 	namespace
 	{
 		uint8_t glBlendingFactorToInt(GLenum blendingFactor)
@@ -191,9 +251,17 @@ namespace nCine
 
 	uint32_t Material::sortKey()
 	{
+		// The hash is recalculated only if textures, shader program or blending factors have changed
+		if (!sortKeyDirty_) {
+			return sortKey_;
+		}
+
 		constexpr uint32_t Seed = 1697381921;
 		// Align to 64 bits for `fasthash64()` to properly work on Emscripten without alignment faults
-		static SortHashData hashData alignas(8);
+		// Not static, so materials can be sorted from more threads at once
+		alignas(8) SortHashData hashData;
+		// Padding has to be cleared, because it's hashed too
+		std::memset(&hashData, 0, sizeof(SortHashData));
 
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
 			hashData.textures[i] = (textures_[i] != nullptr) ? textures_[i]->glHandle() : 0;
@@ -202,7 +270,9 @@ namespace nCine
 		hashData.srcBlendingFactor = glBlendingFactorToInt(srcBlendingFactor_);
 		hashData.destBlendingFactor = glBlendingFactorToInt(destBlendingFactor_);
 
-		return fasthash32(reinterpret_cast<const void*>(&hashData), sizeof(SortHashData), Seed);
+		sortKey_ = fasthash32(reinterpret_cast<const void*>(&hashData), sizeof(SortHashData), Seed);
+		sortKeyDirty_ = false;
+		return sortKey_;
 	}
 
 }
@@ -82,6 +82,11 @@ namespace nCine
 		Material();
 		Material(GLShaderProgram* program, GLTexture* texture);
 
+		/// Move constructor, it resolves the per-instance uniforms again as they point into the moved containers
+		Material(Material&& other) noexcept;
+		/// Move assignment operator, it resolves the per-instance uniforms again as they point into the moved containers
+		Material& operator=(Material&& other) noexcept;
+
 		inline bool isBlendingEnabled() const {
 			return isBlendingEnabled_;
 		}
@@ -142,6 +147,27 @@ namespace nCine
 		bool setTexture(unsigned int unit, const GLTexture* texture);
 		bool setTexture(unsigned int unit, const Texture& texture);
 
+		/// Returns the instance uniform block, it's resolved when the shader program is assigned
+		inline GLUniformBlockCache* instanceBlock() {
+			return instanceBlock_;
+		}
+		/// Returns the model matrix uniform, it's resolved when the shader program is assigned
+		inline GLUniformCache* modelMatrixUniform() {
+			return modelMatrixUniform_;
+		}
+		/// Returns the color uniform of the instance block, it's resolved when the shader program is assigned
+		inline GLUniformCache* colorUniform() {
+			return colorUniform_;
+		}
+		/// Returns the texture rectangle uniform of the instance block, it's resolved when the shader program is assigned
+		inline GLUniformCache* texRectUniform() {
+			return texRectUniform_;
+		}
+		/// Returns the sprite size uniform of the instance block, it's resolved when the shader program is assigned
+		inline GLUniformCache* spriteSizeUniform() {
+			return spriteSizeUniform_;
+		}
+
 		inline const GLTexture* texture() const {
 			return texture(0);
 		}
@@ -163,6 +189,18 @@ namespace nCine
 		GLShaderUniformBlocks shaderUniformBlocks_;
 		const GLTexture* textures_[GLTexture::MaxTextureUnits];
 
+		/// Pre-resolved per-instance uniforms, so hot paths don't have to look them up by name
+		GLUniformBlockCache* instanceBlock_;
+		GLUniformCache* modelMatrixUniform_;
+		GLUniformCache* colorUniform_;
+		GLUniformCache* texRectUniform_;
+		GLUniformCache* spriteSizeUniform_;
+
+		/// Cached hash of textures, shader program and blending factors
+		uint32_t sortKey_;
+		/// Set when the sort key has to be recalculated
+		bool sortKeyDirty_;
+
 		/// The size of the memory buffer containing uniform values
 		unsigned int uniformsHostBufferSize_;
 		/// Memory buffer with uniform values to be sent to the GPU
@@ -179,6 +217,8 @@ namespace nCine
 		}
 		/// Wrapper around `GLShaderProgram::defineVertexFormat()`
 		void defineVertexFormat(const GLBufferObject* vbo, const GLBufferObject* ibo, unsigned int vboOffset);
+		/// Looks up the per-instance uniforms of the current shader program
+		void resolveInstanceUniforms();
 		uint32_t sortKey();
 
 		friend class RenderCommand;
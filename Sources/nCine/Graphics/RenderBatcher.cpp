@@ -147,7 +147,7 @@ namespace nCine
 		batchCommand = RenderResources::renderCommandPool().retrieveOrAdd(batchedShader, commandAdded);
 
 		// Retrieving the original block instance size without the uniform buffer offset alignment
-		const GLUniformBlockCache* singleInstanceBlock = (*start)->material().uniformBlock(Material::InstanceBlockName);
+		const GLUniformBlockCache* singleInstanceBlock = (*start)->material().instanceBlock();
 		const int singleInstanceBlockSizePacked = singleInstanceBlock->size() - singleInstanceBlock->alignAmount(); // remove the uniform buffer offset alignment
 		const int singleInstanceBlockSize = singleInstanceBlockSizePacked + (16 - singleInstanceBlockSizePacked % 16) % 16; // but add the std140 vec4 layout alignment
 
@@ -291,7 +291,7 @@ namespace nCine
 			RenderCommand* command = *it;
 			command->commitNodeTransformation();
 
-			const GLUniformBlockCache* singleInstanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
+			const GLUniformBlockCache* singleInstanceBlock = command->material().instanceBlock();
 			const bool dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
 			ASSERT(dataCopied);
 			instancesBlockOffset += singleInstanceBlockSize;
@@ -13,6 +13,7 @@ namespace nCine
 	///////////////////////////////////////////////////////////
 
 	RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize)
+		: persistentMapping_(false), frameIndex_(0)
 	{
 		buffers_.reserve(4);
 
@@ -47,12 +48,44 @@ namespace nCine
 		uboSpecs.maxSize = static_cast<unsigned long>(uboMaxSize);
 		uboSpecs.alignment = static_cast<unsigned int>(offsetAlignment);
 
+#if !defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+		for (unsigned int i = 0; i < PersistentFrameCount; i++) {
+			frameFences_[i] = nullptr;
+		}
+
+		// Immutable storage is required to keep buffers mapped while the GPU is reading them
+		const int glMajorVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::Major);
+		const int glMinorVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::Minor);
+		const bool hasBufferStorage = (glMajorVersion > 4 || (glMajorVersion == 4 && glMinorVersion >= 4) ||
+			gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_BUFFER_STORAGE));
+		persistentMapping_ = (useBufferMapping && hasBufferStorage);
+		if (persistentMapping_) {
+			LOGI_X("Using persistently mapped buffers with %u frame regions", PersistentFrameCount);
+		}
+#endif
+
 		// Create the first buffer for each type right away
 		for (unsigned int i = 0; i < (int)BufferTypes::Count; i++) {
 			createBuffer(specs_[i]);
 		}
 	}
 
+	RenderBuffersManager::~RenderBuffersManager()
+	{
+#if !defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+		for (unsigned int i = 0; i < PersistentFrameCount; i++) {
+			if (frameFences_[i] != nullptr) {
+				glDeleteSync(frameFences_[i]);
+			}
+		}
+		if (persistentMapping_) {
+			for (ManagedBuffer& buffer : buffers_) {
+				buffer.object->unmap();
+			}
+		}
+#endif
+	}
+
 	///////////////////////////////////////////////////////////
 	// PUBLIC FUNCTIONS
 	///////////////////////////////////////////////////////////
@@ -84,12 +117,14 @@ namespace nCine
 
 		for (ManagedBuffer& buffer : buffers_) {
 			if (buffer.type == type) {
+				// Regions of persistently mapped buffers don't start at a multiple of every vertex stride,
+				// so the alignment has to be computed from the offset inside the whole buffer
 				const unsigned long offset = buffer.size - buffer.freeSpace;
-				const unsigned int alignAmount = (alignment - offset % alignment) % alignment;
+				const unsigned int alignAmount = (alignment - (buffer.frameOffset + offset) % alignment) % alignment;
 
 				if (buffer.freeSpace >= bytes + alignAmount) {
 					params.object = buffer.object.get();
-					params.offset = offset + alignAmount;
+					params.offset = buffer.frameOffset + offset + alignAmount;
 					params.size = bytes;
 					buffer.freeSpace -= bytes + alignAmount;
 					params.mapBase = buffer.mapBase;
@@ -100,11 +135,15 @@ namespace nCine
 
 		if (params.object == nullptr) {
 			createBuffer(specs_[(int)type]);
-			params.object = buffers_.back().object.get();
-			params.offset = 0;
+			ManagedBuffer& buffer = buffers_.back();
+			const unsigned int alignAmount = (alignment - buffer.frameOffset % alignment) % alignment;
+			FATAL_ASSERT(buffer.freeSpace >= bytes + alignAmount);
+
+			params.object = buffer.object.get();
+			params.offset = buffer.frameOffset + alignAmount;
 			params.size = bytes;
-			buffers_.back().freeSpace -= bytes;
-			params.mapBase = buffers_.back().mapBase;
+			buffer.freeSpace -= bytes + alignAmount;
+			params.mapBase = buffer.mapBase;
 		}
 
 		return params;
@@ -122,10 +161,15 @@ namespace nCine
 		for (ManagedBuffer& buffer : buffers_) {
 			RenderStatistics::gatherStatistics(buffer);
 			const unsigned long usedSize = buffer.size - buffer.freeSpace;
-			FATAL_ASSERT(usedSize <= specs_[(int)buffer.type].maxSize);
+			FATAL_ASSERT(usedSize <= buffer.size);
 			buffer.freeSpace = buffer.size;
 
-			if (specs_[(int)buffer.type].mapFlags == 0) {
+			if (persistentMapping_) {
+				// The buffer stays mapped, only the written part of the current region is made visible to the GPU
+				if (usedSize > 0) {
+					buffer.object->flushMappedBufferRange(buffer.frameOffset, usedSize);
+				}
+			} else if (specs_[(int)buffer.type].mapFlags == 0) {
 				if (usedSize > 0) {
 					buffer.object->bufferSubData(0, usedSize, buffer.hostBuffer.get());
 				}
@@ -145,11 +189,23 @@ namespace nCine
 		ZoneScoped;
 		GLDebug::ScopedGroup scoped("RenderBuffersManager::remap()");
 
+#if !defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+		if (persistentMapping_) {
+			// All draw commands reading the current region have been issued, the next region is written in the next frame
+			frameFences_[frameIndex_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			frameIndex_ = (frameIndex_ + 1) % PersistentFrameCount;
+			waitForFrameFence(frameIndex_);
+		}
+#endif
+
 		for (ManagedBuffer& buffer : buffers_) {
 			ASSERT(buffer.freeSpace == buffer.size);
 			ASSERT(buffer.mapBase == nullptr);
 
-			if (specs_[(int)buffer.type].mapFlags == 0) {
+			if (persistentMapping_) {
+				buffer.frameOffset = frameIndex_ * buffer.size;
+				buffer.mapBase = buffer.persistentMapBase;
+			} else if (specs_[(int)buffer.type].mapFlags == 0) {
 				buffer.object->bufferData(buffer.size, nullptr, specs_[(int)buffer.type].usageFlags);
 				buffer.mapBase = buffer.hostBuffer.get();
 			} else {
@@ -166,8 +222,23 @@ namespace nCine
 		managedBuffer.type = specs.type;
 		managedBuffer.size = specs.maxSize;
 		managedBuffer.object = std::make_unique<GLBufferObject>(specs.target);
-		managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
 		managedBuffer.freeSpace = managedBuffer.size;
+#if !defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+		if (persistentMapping_) {
+			// One region for each frame in flight, a new buffer is not used by the GPU yet, so it doesn't need a fence,
+			// regions are padded, so the largest allowed allocation still fits after aligning the start of the region
+			managedBuffer.size += PersistentRegionPadding;
+			managedBuffer.freeSpace = managedBuffer.size;
+			constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+			constexpr GLbitfield MapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+			managedBuffer.object->bufferStorage(managedBuffer.size * PersistentFrameCount, nullptr, StorageFlags);
+			managedBuffer.persistentMapBase = static_cast<GLubyte*>(managedBuffer.object->mapBufferRange(0, managedBuffer.size * PersistentFrameCount, MapFlags));
+			managedBuffer.frameOffset = frameIndex_ * managedBuffer.size;
+		} else
+#endif
+		{
+			managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
+		}
 
 		switch (managedBuffer.type) {
 			default:
@@ -182,7 +253,9 @@ namespace nCine
 				break;
 		}
 
-		if (specs.mapFlags == 0) {
+		if (persistentMapping_) {
+			managedBuffer.mapBase = managedBuffer.persistentMapBase;
+		} else if (specs.mapFlags == 0) {
 			managedBuffer.hostBuffer = std::make_unique<GLubyte[]>(specs.maxSize);
 			managedBuffer.mapBase = managedBuffer.hostBuffer.get();
 		} else {
@@ -195,4 +268,23 @@ namespace nCine
 		//debugString.format("Create %s buffer 0x%lx", bufferTypeToString(specs.type), uintptr_t(buffers_.back().object.get()));
 		//GLDebug::messageInsert(debugString.data());
 	}
+
+#if !defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+	void RenderBuffersManager::waitForFrameFence(unsigned int index)
+	{
+		GLsync fence = frameFences_[index];
+		if (fence == nullptr) {
+			return;
+		}
+
+		ZoneScopedN("Wait for frame fence");
+		// With three regions the fence has usually been signaled already, so the first check doesn't flush
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		while (result == GL_TIMEOUT_EXPIRED) {
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+		}
+		glDeleteSync(fence);
+		frameFences_[index] = nullptr;
+	}
+#endif
 }
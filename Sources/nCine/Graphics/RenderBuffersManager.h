@@ -45,6 +45,7 @@ namespace nCine
 		};
 
 		RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize);
+		~RenderBuffersManager();
 
 		/// Returns the specifications for a buffer of the specified type
 		inline const BufferSpecifications& specs(BufferTypes type) const {
@@ -57,13 +58,24 @@ namespace nCine
 		/// Requests an amount of bytes from the specified buffer type with a custom alignment requirement
 		Parameters acquireMemory(BufferTypes type, unsigned long bytes, unsigned int alignment);
 
+		/// Returns true if buffers are persistently mapped and cycled every frame
+		inline bool usesPersistentMapping() const {
+			return persistentMapping_;
+		}
+
 	private:
+		/// Number of frame regions of a persistently mapped buffer, the CPU writes one while the GPU reads the others
+		static constexpr unsigned int PersistentFrameCount = 3;
+		/// Additional space of each persistent region for aligning allocations, it's greater than any vertex stride or buffer offset alignment
+		static constexpr unsigned int PersistentRegionPadding = 256;
+
 		BufferSpecifications specs_[(int)BufferTypes::Count];
 
 		struct ManagedBuffer
 		{
 			ManagedBuffer()
-				: type(BufferTypes::Array), size(0), freeSpace(0), object(nullptr), mapBase(nullptr), hostBuffer(nullptr) {}
+				: type(BufferTypes::Array), size(0), freeSpace(0), object(nullptr), mapBase(nullptr), hostBuffer(nullptr),
+				frameOffset(0), persistentMapBase(nullptr) {}
 
 			BufferTypes type;
 			std::unique_ptr<GLBufferObject> object;
@@ -71,10 +83,26 @@ namespace nCine
 			unsigned long freeSpace;
 			GLubyte* mapBase;
 			std::unique_ptr<GLubyte[]> hostBuffer;
+			/// Offset of the region used in the current frame, it's always zero without persistent mapping
+			unsigned long frameOffset;
+			/// Pointer to the whole persistently mapped buffer
+			GLubyte* persistentMapBase;
 		};
 
 		SmallVector<ManagedBuffer, 0> buffers_;
 
+		/// The flag is `true` if buffers have immutable storage that stays mapped for their whole lifetime
+		bool persistentMapping_;
+		/// Index of the frame region that is written in the current frame
+		unsigned int frameIndex_;
+#if !defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+		/// Fences signaled when the GPU has finished reading a frame region
+		GLsync frameFences_[PersistentFrameCount];
+
+		/// Waits until the GPU has finished reading the region that is going to be written
+		void waitForFrameFence(unsigned int index);
+#endif
+
 		void flushUnmap();
 		void remap();
 		void createBuffer(const BufferSpecifications& specs);
@@ -30,9 +30,10 @@ namespace nCine
 
 	void RenderCommand::calculateMaterialSortKey()
 	{
+		// Material hash is cached, only the layer part changes every frame
 		const uint64_t upper = static_cast<uint64_t>(layerSortKey()) << 32;
 		const uint32_t lower = material_.sortKey();
-		materialSortKey_ = upper + lower;
+		materialSortKey_ = upper | lower;
 	}
 
 	void RenderCommand::issue()
@@ -88,10 +89,7 @@ namespace nCine
 		modelMatrix_[3][2] = calculateDepth(layer_, cameraValues.near, cameraValues.far);
 
 		if (material_.shaderProgram_ && material_.shaderProgram_->status() == GLShaderProgram::Status::LinkedWithIntrospection) {
-			GLUniformBlockCache* instanceBlock = material_.uniformBlock(Material::InstanceBlockName);
-			GLUniformCache* matrixUniform = instanceBlock
-				? instanceBlock->uniform(Material::ModelMatrixUniformName)
-				: material_.uniform(Material::ModelMatrixUniformName);
+			GLUniformCache* matrixUniform = material_.modelMatrixUniform();
 			if (matrixUniform) {
 				ZoneScopedN("Set model matrix");
 				matrixUniform->setFloatVector(modelMatrix_.Data());
@@ -55,6 +55,12 @@ namespace nCine
 
 	namespace
 	{
+		/// Queues smaller than this are sorted by comparison, radix sort histograms would not pay off
+		constexpr unsigned int RadixSortThreshold = 64;
+		/// Number of 8-bit digits in the id sort key and in the material sort key
+		constexpr unsigned int IdKeyDigits = 4;
+		constexpr unsigned int KeyDigits = IdKeyDigits + 8;
+
 		bool descendingOrder(const RenderCommand* a, const RenderCommand* b)
 		{
 			return (a->materialSortKey() != b->materialSortKey())
@@ -89,8 +95,11 @@ namespace nCine
 		const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
 
 		// Sorting the queues with the relevant orders
-		quicksort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
-		quicksort(transparentQueue_.begin(), transparentQueue_.end(), ascendingOrder);
+		{
+			ZoneScopedN("Sorting");
+			sortQueue(opaqueQueue_, true);
+			sortQueue(transparentQueue_, false);
+		}
 
 		SmallVectorImpl<RenderCommand*>* opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
 		SmallVectorImpl<RenderCommand*>* transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
@@ -201,6 +210,81 @@ namespace nCine
 		GLScissorTest::disable();
 	}
 
+	///////////////////////////////////////////////////////////
+	// PRIVATE FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void RenderQueue::sortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending)
+	{
+		const unsigned int count = queue.size();
+		if (count < RadixSortThreshold) {
+			quicksort(queue.begin(), queue.end(), descending ? descendingOrder : ascendingOrder);
+			return;
+		}
+
+		sortEntries_.resize_for_overwrite(count);
+		sortEntriesTemp_.resize_for_overwrite(count);
+
+		// Keys are copied to a compact array, so the passes don't have to touch the commands.
+		// Descending order is achieved by sorting inverted keys.
+		const uint64_t materialKeyMask = (descending ? ~uint64_t(0) : 0);
+		const uint32_t idKeyMask = (descending ? ~uint32_t(0) : 0);
+		uint32_t histograms[KeyDigits][256] = {};
+		for (unsigned int i = 0; i < count; i++) {
+			SortEntry& entry = sortEntries_[i];
+			entry.materialKey = queue[i]->materialSortKey() ^ materialKeyMask;
+			entry.idKey = queue[i]->idSortKey() ^ idKeyMask;
+			entry.index = i;
+
+			for (unsigned int j = 0; j < IdKeyDigits; j++) {
+				histograms[j][(entry.idKey >> (j * 8)) & 0xff]++;
+			}
+			for (unsigned int j = IdKeyDigits; j < KeyDigits; j++) {
+				histograms[j][(entry.materialKey >> ((j - IdKeyDigits) * 8)) & 0xff]++;
+			}
+		}
+
+		// Least significant digits first, the id sort key is the secondary key, so it goes before the material sort key
+		SortEntry* src = sortEntries_.data();
+		SortEntry* dst = sortEntriesTemp_.data();
+		for (unsigned int j = 0; j < KeyDigits; j++) {
+			uint32_t* histogram = histograms[j];
+			const unsigned int firstDigit = (j < IdKeyDigits
+				? (src[0].idKey >> (j * 8)) & 0xff
+				: (src[0].materialKey >> ((j - IdKeyDigits) * 8)) & 0xff);
+			// Skipping the pass if all the entries share the same digit
+			if (histogram[firstDigit] == count) {
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (unsigned int k = 0; k < 256; k++) {
+				const uint32_t bucketSize = histogram[k];
+				histogram[k] = offset;
+				offset += bucketSize;
+			}
+
+			if (j < IdKeyDigits) {
+				for (unsigned int i = 0; i < count; i++) {
+					dst[histogram[(src[i].idKey >> (j * 8)) & 0xff]++] = src[i];
+				}
+			} else {
+				for (unsigned int i = 0; i < count; i++) {
+					dst[histogram[(src[i].materialKey >> ((j - IdKeyDigits) * 8)) & 0xff]++] = src[i];
+				}
+			}
+			std::swap(src, dst);
+		}
+
+		sortedQueue_.resize_for_overwrite(count);
+		for (unsigned int i = 0; i < count; i++) {
+			sortedQueue_[i] = queue[src[i].index];
+		}
+		for (unsigned int i = 0; i < count; i++) {
+			queue[i] = sortedQueue_[i];
+		}
+	}
+
 	void RenderQueue::clear()
 	{
 		opaqueQueue_.clear();
@@ -30,6 +30,14 @@ namespace nCine
 		void clear();
 
 	private:
+		/// Sort keys of a render command packed with its index in the queue
+		struct SortEntry
+		{
+			uint64_t materialKey;
+			uint32_t idKey;
+			uint32_t index;
+		};
+
 		/// Array of opaque render command pointers
 		SmallVector<RenderCommand*, 0> opaqueQueue_;
 		/// Array of opaque batched render command pointers
@@ -38,6 +46,14 @@ namespace nCine
 		SmallVector<RenderCommand*, 0> transparentQueue_;
 		/// Array of transparent batched render command pointers
 		SmallVector<RenderCommand*, 0> transparentBatchedQueue_;
+
+		/// Sort entries and scratch buffers reused by the radix sort
+		SmallVector<SortEntry, 0> sortEntries_;
+		SmallVector<SortEntry, 0> sortEntriesTemp_;
+		SmallVector<RenderCommand*, 0> sortedQueue_;
+
+		/// Sorts the queue by material and id sort keys with a stable LSD radix sort
+		void sortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending);
 	};
 
 }
@@ -15,6 +15,7 @@ namespace nCine
 	RenderStatistics::CustomBuffers RenderStatistics::customIbos_;
 	unsigned int RenderStatistics::index_ = 0;
 	unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
+	RenderStatistics::CachedCommands RenderStatistics::cachedCommands_[2];
 	RenderStatistics::VaoPool RenderStatistics::vaoPool_;
 	RenderStatistics::CommandPool RenderStatistics::commandPool_;
 
@@ -26,6 +27,8 @@ namespace nCine
 	{
 		TracyPlot("Vertices", static_cast<int64_t>(allCommands_.vertices));
 		TracyPlot("Render Commands", static_cast<int64_t>(allCommands_.commands));
+		TracyPlot("Cached Commands", static_cast<int64_t>(cachedCommands_[index_].commands));
+		TracyPlot("Replaced Commands", static_cast<int64_t>(cachedCommands_[index_].replacedCommands));
 
 		for (unsigned int i = 0; i < (unsigned int)RenderCommand::CommandTypes::Count; i++) {
 			typedCommands_[i].reset();
@@ -39,6 +42,7 @@ namespace nCine
 		// Ping pong index for last and current frame
 		index_ = (index_ + 1) % 2;
 		culledNodes_[index_] = 0;
+		cachedCommands_[index_].reset();
 
 		vaoPool_.reset();
 		commandPool_.reset();
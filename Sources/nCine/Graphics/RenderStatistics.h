@@ -130,6 +130,29 @@ namespace nCine
 			friend RenderStatistics;
 		};
 
+		class CachedCommands
+		{
+		public:
+			/// Number of commands that draw cached geometry
+			unsigned int commands;
+			/// Number of individual commands that the cached geometry replaced
+			unsigned int replacedCommands;
+			/// Number of times the cached geometry had to be rebuilt
+			unsigned int rebuilds;
+
+			CachedCommands()
+				: commands(0), replacedCommands(0), rebuilds(0) {}
+
+		private:
+			void reset()
+			{
+				commands = 0;
+				replacedCommands = 0;
+				rebuilds = 0;
+			}
+			friend RenderStatistics;
+		};
+
 		/// Returns the aggregated command statistics for all types
 		static inline const Commands& allCommands() {
 			return allCommands_;
@@ -164,6 +187,21 @@ namespace nCine
 			return culledNodes_[(index_ + 1) % 2];
 		}
 
+		/// Returns statistics about commands with cached geometry from the last frame
+		static inline const CachedCommands& cachedCommands() {
+			return cachedCommands_[(index_ + 1) % 2];
+		}
+
+		/// Records a command with cached geometry that replaces the specified number of individual commands
+		static inline void addCachedCommand(unsigned int replacedCommands) {
+			cachedCommands_[index_].commands++;
+			cachedCommands_[index_].replacedCommands += replacedCommands;
+		}
+		/// Records a rebuild of cached geometry
+		static inline void addCachedGeometryRebuild() {
+			cachedCommands_[index_].rebuilds++;
+		}
+
 		/// Returns statistics about the VAO pool
 		static inline const VaoPool& vaoPool() {
 			return vaoPool_;
@@ -183,6 +221,7 @@ namespace nCine
 		static CustomBuffers customIbos_;
 		static unsigned int index_;
 		static unsigned int culledNodes_[2];
+		static CachedCommands cachedCommands_[2];
 		static VaoPool vaoPool_;
 		static CommandPool commandPool_;
 
@@ -13,6 +13,7 @@
 #include "GL/GLDebug.h"
 #include "../ServiceLocator.h"
 #include "../tracy.h"
+#include "../tracy_opengl.h"
 #include "../../Common.h"
 
 #ifdef WITH_QT5
@@ -70,7 +71,7 @@ namespace nCine
 		depthStencilFormat_(DepthStencilFormat::None), lastFrameCleared_(0),
 		clearMode_(ClearMode::EveryFrame), clearColor_(Colorf::Black),
 		renderQueue_(std::make_unique<RenderQueue>()),
-		fbo_(nullptr), rootNode_(nullptr), camera_(nullptr),
+		fbo_(nullptr), rootNode_(nullptr), camera_(nullptr), name_(name),
 		stateBits_(0), numColorAttachments_(0)
 	{
 		for (unsigned int i = 0; i < MaxNumTextures; i++)
@@ -432,6 +433,8 @@ namespace nCine
 		RenderResources::updateCameraUniforms();
 
 		if (!renderQueue_->empty()) {
+			TracyGpuZoneTransient(___tracy_gpu_viewport_zone, name_ != nullptr ? name_ : "Viewport", true);
+
 			const bool viewportRectNonZeroArea = (viewportRect_.W > 0 && viewportRect_.H > 0);
 			const GLViewport::State viewportState = GLViewport::state();
 			if (viewportRectNonZeroArea) {
@@ -243,6 +243,9 @@ namespace nCine
 		/*! \note If set to `nullptr` it will use the default camera */
 		Camera* camera_;
 
+		/// The name used for profiler zones, the string is not copied
+		const char* name_;
+
 		/// Bitset that stores the various states bits
 		BitSet<uint8_t> stateBits_;
 
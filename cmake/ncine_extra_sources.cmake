@@ -103,6 +103,7 @@ if(OPENAL_FOUND)
 		${NCINE_SOURCE_DIR}/nCine/Audio/AudioBufferPlayer.h
 		${NCINE_SOURCE_DIR}/nCine/Audio/AudioStreamPlayer.h
 		${NCINE_SOURCE_DIR}/nCine/Audio/ALAudioDevice.h
+		${NCINE_SOURCE_DIR}/nCine/Audio/CaptureAudioDevice.h
 		${NCINE_SOURCE_DIR}/nCine/Audio/IAudioLoader.h
 		${NCINE_SOURCE_DIR}/nCine/Audio/AudioLoaderWav.h
 		${NCINE_SOURCE_DIR}/nCine/Audio/AudioReaderWav.h
@@ -111,6 +112,7 @@ if(OPENAL_FOUND)
 
 	list(APPEND SOURCES
 		${NCINE_SOURCE_DIR}/nCine/Audio/ALAudioDevice.cpp
+		${NCINE_SOURCE_DIR}/nCine/Audio/CaptureAudioDevice.cpp
 		${NCINE_SOURCE_DIR}/nCine/Audio/IAudioLoader.cpp
 		${NCINE_SOURCE_DIR}/nCine/Audio/AudioLoaderWav.cpp
 		${NCINE_SOURCE_DIR}/nCine/Audio/AudioReaderWav.cpp
@@ -148,6 +148,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/PreferencesCache.h
 	${NCINE_SOURCE_DIR}/Jazz2/WeatherType.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.h
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.h
@@ -98,6 +98,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/LevelHandler.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/PreferencesCache.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.cpp
@@ -220,6 +221,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/RegisterString.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptActorWrapper.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptPlayerWrapper.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptProfiler.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileSet.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Canvas.cpp